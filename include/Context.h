@@ -9,7 +9,8 @@
 //	YSLib::in_place_type, YSLib::in_place_type_t, YSLib::make_unique,
 //	std::allocator_arg_t, Unilang::Deref, EnvironmentBase, pmr, string_view,
 //	AnchorPtr, type_info, std::allocator_arg, lref, Unilang::allocate_shared,
-//	Unilang::AssertMatchedAllocators, Unilang::AsTermNode, stack;
+//	Unilang::AssertMatchedAllocators, Unilang::AsTermNode, stack, TokenValue,
+//	HashSymbolName;
 #include <ystdex/functor.hpp> // for ystdex::equal_to;
 #include <ystdex/allocator.hpp> // for ystdex::allocator_delete,
 //	ystdex::rebind_alloc_t, ystdex::make_obj_using_allocator;
@@ -30,12 +31,15 @@
 #include <cassert> // for assert;
 #include <ystdex/functor.hpp> // for ystdex::ref_eq;
 #include <exception> // for std::exception_ptr;
-#include "Parser.h" // for ParseResultOf, ByteParser, SourcedByteParser;
-#include "Lexical.h" // for LexicalAnalyzer;
+#include "Parser.h" // for ParseResultOf, ByteParser, SourcedByteParser,
+//	ViewByteParser, SourcedViewByteParser;
+#include "Lexical.h" // for LexicalAnalyzer, SourceName, SourceTag,
+//	SourceLocation;
 #include <ystdex/ref.hpp> // for ystdex::ref, ystdex::unref;
 #include <algorithm> // for std::for_each;
 #include <streambuf> // for std::streambuf;
 #include <istream> // for std::istream;
+#include "Memory.h" // for ArenaResource, ArenaRewindGuard;
 
 namespace Unilang
 {
@@ -62,31 +66,53 @@ public:
 	operator()(const char* s) const noexcept
 	{
 		assert(s);
-		return DoHash(s);
+		return HashSymbolName(s);
+	}
+	// NOTE: The hash of the interned symbol is precomputed.
+	YB_ATTR_nodiscard YB_PURE size_t
+	operator()(const TokenValue& s) const noexcept
+	{
+		return s.GetHash();
 	}
 	template<class _tString>
 	YB_ATTR_nodiscard YB_PURE size_t
 	operator()(const _tString& str) const noexcept
 	{
-		return DoHash(ystdex::make_string_view(str));
+		return HashSymbolName(ystdex::make_string_view(str));
 	}
+};
+
+using BindingMap
+	= unordered_map<string, TermNode, SymbolStringHash, ystdex::equal_to<>>;
+
 
+class SymbolTable final
+{
 private:
+	// NOTE: The nodes are stable, so are the names in the keys.
+	using NameMap
+		= unordered_map<string, size_t, SymbolStringHash, ystdex::equal_to<>>;
+
+	NameMap names;
+
+public:
+	SymbolTable(NameMap::allocator_type a = {})
+		: names(a)
+	{}
+	SymbolTable(const SymbolTable&) = delete;
+
+	SymbolTable&
+	operator=(const SymbolTable&) = delete;
+
 	YB_ATTR_nodiscard YB_PURE size_t
-	DoHash(const string_view& k) const noexcept
+	size() const noexcept
 	{
-		auto first(reinterpret_cast<const unsigned char*>(k.data()));
-		size_t h(5381);
-
-		for(auto n = k.size(); n != 0; --n)
-			h = size_t(ystdex::plus<>()(ystdex::multiplies<>()(h,
-				size_t(65599)), size_t(*first++)));
-		return h;
+		return names.size();
 	}
-};
 
-using BindingMap
-	= unordered_map<string, TermNode, SymbolStringHash, ystdex::equal_to<>>;
+	YB_ATTR_nodiscard TokenValue
+	Intern(string_view);
+};
 
 using NameResolution
 	= pair<observer_ptr<BindingMap::mapped_type>, shared_ptr<Environment>>;
@@ -99,6 +125,18 @@ template<class _tParent>
 using GParentDeleter = ystdex::allocator_delete<ystdex::rebind_alloc_t<
 	ParentAllocator, _tParent>>;
 
+// NOTE: The kinds of the parents known by the implementation, to avoid the
+//	dynamic casts.
+enum class ParentKind
+{
+	Other,
+	Empty,
+	SingleWeak,
+	SingleStrong,
+	List
+};
+
+
 struct IParent : private ystdex::equality_comparable<IParent>
 {
 	using Redirector
@@ -119,6 +157,12 @@ struct IParent : private ystdex::equality_comparable<IParent>
 	YB_ATTR_nodiscard YB_PURE virtual bool
 	Equals(const IParent&) const = 0;
 
+	YB_ATTR_nodiscard YB_PURE virtual ParentKind
+	GetKind() const noexcept
+	{
+		return ParentKind::Other;
+	}
+
 	YB_ATTR_nodiscard virtual shared_ptr<Environment>
 	TryRedirect(Redirector&) const = 0;
 
@@ -154,6 +198,12 @@ public:
 		return x.type() == type_id<EmptyParent>();
 	}
 
+	YB_ATTR_nodiscard YB_STATELESS ParentKind
+	GetKind() const noexcept override
+	{
+		return ParentKind::Empty;
+	}
+
 	YB_ATTR_nodiscard YB_STATELESS shared_ptr<Environment>
 	TryRedirect(Redirector&) const noexcept override
 	{
@@ -254,6 +304,12 @@ public:
 			&& static_cast<const SingleWeakParent&>(x) == *this;
 	}
 
+	YB_ATTR_nodiscard YB_STATELESS ParentKind
+	GetKind() const noexcept override
+	{
+		return ParentKind::SingleWeak;
+	}
+
 	YB_ATTR_nodiscard shared_ptr<Environment>
 	TryRedirect(Redirector&) const override;
 
@@ -364,6 +420,12 @@ public:
 			&& static_cast<const SingleStrongParent&>(x) == *this;
 	}
 
+	YB_ATTR_nodiscard YB_STATELESS ParentKind
+	GetKind() const noexcept override
+	{
+		return ParentKind::SingleStrong;
+	}
+
 	YB_ATTR_nodiscard shared_ptr<Environment>
 	TryRedirect(Redirector&) const override;
 
@@ -547,6 +609,12 @@ public:
 			&& static_cast<const ParentList&>(x) == *this;
 	}
 
+	YB_ATTR_nodiscard YB_STATELESS ParentKind
+	GetKind() const noexcept override
+	{
+		return ParentKind::List;
+	}
+
 	YB_ATTR_nodiscard shared_ptr<Environment>
 	TryRedirect(Redirector&) const override;
 
@@ -578,13 +646,40 @@ public:
 	using allocator_type = BindingMap::allocator_type;
 
 private:
-	mutable BindingMap bindings;
-
-public:
-	EnvironmentParent Parent{};
+	struct IndexEntry final
+	{
+		size_t Hash;
+		BindingMap::value_type* Binding;
+	};
 
-private:
+	mutable BindingMap bindings;
+	// NOTE: The read-only index of the bindings built by %FreezeIndexed. It
+	//	is an open addressing table whose size is a power of 2 not less than
+	//	twice of the number of the bindings, so the lookup of a name mostly
+	//	takes one probe. It is dropped once the bindings can be modified.
+	vector<IndexEntry> index{};
+	// NOTE: The slots of the bindings in a small environment, built by
+	//	%IndexFrame, usually for the fresh environment of a call after the
+	//	parameters are bound. The valid slots cover all bindings, so the
+	//	lookup of a name not in the slots needs no access to the map. The
+	//	slots are also dropped once the bindings can be modified.
+	array<IndexEntry, 4> frame{};
+	size_t frame_size = size_t(-1);
+	EnvironmentParent parent{};
 	bool frozen = {};
+	// NOTE: The serial number is unique to each environment object, so the
+	//	entries of a %ResolutionCache keyed by a destroyed environment are not
+	//	matched by another one allocated at the same address.
+	size_t cache_serial = AllocateCacheSerial();
+	// NOTE: The version is changed on any modification of the bindings, the
+	//	parent or the frozen state. The resolution kept in a %ResolutionCache
+	//	is invalidated by the change of the version of any environment
+	//	traversed by the resolution.
+	mutable size_t cache_version = 0;
+
+	// NOTE: The compressor modifies the parents in place, and it invalidates
+	//	the cache of each environment modified by itself.
+	friend struct RecordCompressor;
 
 public:
 	Environment(allocator_type a)
@@ -606,11 +701,11 @@ public:
 	{}
 	Environment(const EnvironmentParent& ep, allocator_type a)
 		: EnvironmentBase(InitAnchor(a)),
-		bindings(a), Parent(ep)
+		bindings(a), parent(ep)
 	{}
 	Environment(EnvironmentParent&& ep, allocator_type a)
 		: EnvironmentBase(InitAnchor(a)),
-		bindings(a), Parent(std::move(ep))
+		bindings(a), parent(std::move(ep))
 	{}
 	Environment(pmr::memory_resource& rsrc, const EnvironmentParent& ep)
 		: Environment(ep, allocator_type(&rsrc))
@@ -620,7 +715,7 @@ public:
 	{}
 	Environment(const Environment& e)
 		: EnvironmentBase(InitAnchor(e.bindings.get_allocator())),
-		bindings(e.bindings), Parent(e.Parent)
+		bindings(e.bindings), parent(e.parent)
 	{}
 	Environment(Environment&&) = default;
 
@@ -650,25 +745,64 @@ public:
 	{
 		return bindings;
 	}
-	YB_ATTR_nodiscard YB_PURE BindingMap&
+	// NOTE: The following functions are not pure. The bindings are assumed to
+	//	be modified through the result, so the cached resolution and the
+	//	indices are invalidated on each call. The result shall not be kept to
+	//	add or remove the bindings after another resolution in the
+	//	environment or its children, which is not invalidated again.
+	YB_ATTR_nodiscard BindingMap&
 	GetMapCheckedRef();
-	YB_ATTR_nodiscard YB_PURE BindingMap&
+	YB_ATTR_nodiscard BindingMap&
 	GetMapRef() noexcept
 	{
 		assert(!IsFrozen() && "Frozen environment found.");
+		InvalidateCache();
+		DropIndex();
 		return bindings;
 	}
-	YB_ATTR_nodiscard YB_PURE BindingMap&
+	YB_ATTR_nodiscard BindingMap&
 	GetMapUncheckedRef() noexcept
 	{
+		InvalidateCache();
+		DropIndex();
 		return bindings;
 	}
+	YB_ATTR_nodiscard YB_PURE const EnvironmentParent&
+	GetParent() const noexcept
+	{
+		return parent;
+	}
+	YB_ATTR_nodiscard YB_PURE size_t
+	GetCacheSerial() const noexcept
+	{
+		return cache_serial;
+	}
+	YB_ATTR_nodiscard YB_PURE size_t
+	GetCacheVersion() const noexcept
+	{
+		return cache_version;
+	}
+
+	void
+	SetParent(const EnvironmentParent& ep)
+	{
+		parent = ep;
+		InvalidateCache();
+	}
+	void
+	SetParent(EnvironmentParent&& ep) noexcept
+	{
+		parent = std::move(ep);
+		InvalidateCache();
+	}
 
 	template<typename _tKey, typename... _tParams>
 	inline ystdex::enable_if_inconvertible_t<_tKey&&,
 		BindingMap::const_iterator, bool>
 	AddValue(_tKey&& k, _tParams&&... args)
 	{
+		InvalidateCache();
+		DropIndex();
 		return ystdex::try_emplace(bindings, yforward(k), NoContainer,
 			yforward(args)...).second;
 	}
@@ -676,6 +810,8 @@ public:
 	inline bool
 	AddValue(BindingMap::const_iterator hint, _tKey&& k, _tParams&&... args)
 	{
+		InvalidateCache();
+		DropIndex();
 		return ystdex::try_emplace_hint(bindings, hint, yforward(k),
 			NoContainer, yforward(args)...).second;
 	}
@@ -697,17 +833,56 @@ public:
 	void
 	Freeze() noexcept
 	{
+		InvalidateCache();
 		frozen = true;
 	}
 
+	// NOTE: Freeze the environment and build the index for the lookup.
+	void
+	FreezeIndexed();
+
+	// NOTE: Build the slots if there are only a few bindings.
+	void
+	IndexFrame() noexcept;
+
 private:
+	void
+	DropIndex() noexcept
+	{
+		index.clear();
+		frame_size = size_t(-1);
+	}
+
+	YB_ATTR_nodiscard YB_PURE bool
+	HasFrame() const noexcept
+	{
+		return frame_size <= frame.size();
+	}
+
 	YB_ATTR_nodiscard YB_PURE AnchorPtr
 	InitAnchor(allocator_type a) const;
 
+	YB_ATTR_nodiscard static size_t
+	AllocateCacheSerial() noexcept;
+
 public:
+	void
+	InvalidateCache() const noexcept
+	{
+		++cache_version;
+	}
+
 	YB_ATTR_nodiscard YB_PURE NameResolution::first_type
 	LookupName(string_view) const;
+	YB_ATTR_nodiscard YB_PURE NameResolution::first_type
+	LookupName(const TokenValue&) const;
+
+private:
+	template<typename _tKey>
+	YB_ATTR_nodiscard YB_PURE NameResolution::first_type
+	LookupIndexed(const _tKey&, size_t) const;
 
+public:
 	YB_ATTR_nodiscard YB_PURE TermTags
 	MakeTermTags(const TermNode& term) const noexcept
 	{
@@ -720,11 +895,57 @@ public:
 	void
 	Unfreeze() noexcept
 	{
+		InvalidateCache();
+		DropIndex();
 		frozen = {};
 	}
 };
 
 
+// NOTE: The cache of the name resolution from the environments, mostly the
+//	static environments of the combiners found by the redirection from the
+//	fresh environments of the calls. The entries are indexed by the
+//	environments and the addresses of interned names. Each entry keeps the
+//	environments traversed by the resolution with their cache versions, and
+//	it is valid only if none of them has its version changed since the entry
+//	is saved. The environments are not owned by the entries. The key is
+//	checked by the serial number, and each other environment is found again
+//	from the parent of the previous one, which is not changed if the version
+//	of the previous one is not changed. So only the resolution through the
+//	parents of single environments is kept. Only successful resolution not
+//	traversing more than %MaxDepth environments is kept.
+class ResolutionCache final
+{
+public:
+	enum : size_t
+	{
+		MaxDepth = 4
+	};
+
+private:
+	struct Step final
+	{
+		const Environment* Pointer;
+		size_t Version;
+	};
+	struct Entry final
+	{
+		const Environment* Key = {};
+		size_t KeySerial = 0;
+		const char* Name = {};
+		NameResolution::first_type Object{};
+		size_t Depth = 0;
+		array<Step, MaxDepth> Steps{};
+	};
+
+	array<Entry, 128> entries{};
+
+public:
+	YB_ATTR_nodiscard NameResolution
+	Resolve(shared_ptr<Environment>, const TokenValue&);
+};
+
+
 class Context;
 
 using ReducerFunctionType = ReductionStatus(Context&);
@@ -899,6 +1120,7 @@ private:
 	ReducerSequence
 		current{ReducerSequence::allocator_type(&memory_rsrc.get())};
 	ReducerSequenceBase stashed{current.get_allocator()};
+	size_t stashed_size = 0;
 	ReducerSequence stacked{current.get_allocator()};
 
 public:
@@ -910,6 +1132,13 @@ public:
 private:
 	TermNode* next_term_ptr = {};
 	TermNode* combining_term_ptr = {};
+	mutable ResolutionCache resolution_cache{};
+	// NOTE: The cleared bindings of the released environments, to be reused
+	//	by the fresh environments. Only the storage of the bindings is kept,
+	//	so the environment objects are never reused. The capacity is reserved
+	//	on construction and never exceeded.
+	vector<BindingMap> recycled{
+		vector<BindingMap>::allocator_type(&memory_rsrc.get())};
 
 public:
 	Continuation ReduceOnce{DefaultReduceOnce, *this};
@@ -1023,6 +1252,8 @@ public:
 
 	YB_ATTR_nodiscard NameResolution
 	Resolve(shared_ptr<Environment>, string_view) const;
+	YB_ATTR_nodiscard NameResolution
+	Resolve(shared_ptr<Environment>, const TokenValue&) const;
 
 	void
 	SaveExceptionHandler()
@@ -1049,6 +1280,7 @@ public:
 			stashed.front() = std::move(act);
 			current.splice_after(current.cbefore_begin(), stashed,
 				stashed.cbefore_begin());
+			--stashed_size;
 		}
 		else
 			current.push_front(std::move(act));
@@ -1078,6 +1310,18 @@ public:
 			i);
 	}
 
+	// NOTE: Allocate a fresh environment using the allocator of the current
+	//	environment, reusing the recycled bindings if any.
+	YB_ATTR_nodiscard shared_ptr<Environment>
+	AllocateFreshEnvironment();
+
+	// NOTE: Recycle the bindings of the environment if it is not referenced
+	//	elsewhere, as indicated by both the use count and the anchor count.
+	//	Then the environment is destroyed and the pointer is reset.
+	//	Otherwise, the pointer is not changed.
+	void
+	RecycleEnvironment(shared_ptr<Environment>&) noexcept;
+
 	shared_ptr<Environment>
 	SwitchEnvironment(shared_ptr<Environment>);
 
@@ -1116,6 +1360,7 @@ public:
 	shrink_to_fit() noexcept
 	{
 		stashed.clear();
+		stashed_size = 0;
 	}
 };
 
@@ -1189,6 +1434,11 @@ AllocateEnvironment(TermNode& term, Context& ctx, _tParams&&... args)
 	return Unilang::AllocateEnvironment(a, yforward(args)...);
 }
 
+inline shared_ptr<Environment>
+SwitchToFreshEnvironment(Context& ctx)
+{
+	return ctx.SwitchEnvironmentUnchecked(ctx.AllocateFreshEnvironment());
+}
 template<typename... _tParams>
 inline shared_ptr<Environment>
 SwitchToFreshEnvironment(Context& ctx, _tParams&&... args)
@@ -1304,7 +1554,10 @@ template<typename... _tParams>
 inline void
 AssignParent(Context& ctx, _tParams&&... args)
 {
-	Unilang::AssignParent(ctx.GetRecordRef().Parent, yforward(args)...);
+	EnvironmentParent parent;
+
+	Unilang::AssignParent(parent, yforward(args)...);
+	ctx.GetRecordRef().SetParent(std::move(parent));
 }
 
 
@@ -1326,7 +1579,12 @@ struct EnvironmentSwitcher
 	operator()() const noexcept
 	{
 		if(SavedPtr)
-			ContextRef.get().SwitchEnvironmentUnchecked(std::move(SavedPtr));
+		{
+			auto& ctx(ContextRef.get());
+			auto p_env(ctx.SwitchEnvironmentUnchecked(std::move(SavedPtr)));
+
+			ctx.RecycleEnvironment(p_env);
+		}
 	}
 
 	shared_ptr<Environment>
@@ -1353,26 +1611,51 @@ RelaySwitched(Context& ctx, _fCurrent&& cur)
 }
 
 
+// NOTE: The children of each branch are classified once. The separators and
+//	the infix operators are then transformed by the positions in the
+//	classification, and the subterms are relinked rather than copied.
 class SeparatorPass final
 {
 private:
 	using TermStackEntry = pair<lref<TermNode>, bool>;
 	using TermStack = stack<TermStackEntry, vector<TermStackEntry>>;
 	struct TransformationSpec;
+	struct Layout;
+	struct WorkItem;
+	struct WorkList;
 
 	TermNode::allocator_type allocator;
+	// NOTE: If set, the arena is rewound after each call.
+	observer_ptr<ArenaResource> scratch_arena;
+	// NOTE: The allocator for the temporary objects in the transformations.
+	TermNode::allocator_type scratch_allocator;
 	vector<TransformationSpec> transformations;
 	mutable TermStack remained{allocator};
 
 public:
-	SeparatorPass(TermNode::allocator_type);
+	// NOTE: The temporary objects are allocated from the arena if it is not
+	//	null. Otherwise, they are allocated by the allocator.
+	SeparatorPass(SymbolTable&, TermNode::allocator_type,
+		observer_ptr<ArenaResource>);
 	~SeparatorPass();
 
 	ReductionStatus
 	operator()(TermNode&) const;
 
+private:
+	YB_ATTR_nodiscard unsigned char
+	Classify(const TermNode&) const noexcept;
+
+	YB_ATTR_nodiscard Layout
+	MakeLayout(vector<unsigned char>&&) const;
+
+public:
 	void
 	Transform(TermNode&, bool, TermStack&) const;
+
+private:
+	void
+	TransformItem(const WorkItem&, WorkList&, TermStack&) const;
 };
 
 
@@ -1383,9 +1666,12 @@ template<typename _fParse, typename... _tParams>
 using GTokenizer
 	= function<TermNode(const GParsedValue<_fParse>&, _tParams...)>;
 
-using Tokenizer = GTokenizer<ByteParser>;
+using Tokenizer = GTokenizer<ViewByteParser>;
+
+using SourcedTokenizer = GTokenizer<SourcedViewByteParser, Context&>;
+
 
-using SourcedTokenizer = GTokenizer<SourcedByteParser, Context&>;
+class TermImageCache;
 
 
 class GlobalState
@@ -1398,29 +1684,59 @@ private:
 		YB_ATTR_nodiscard TermNode
 		operator()(const GParsedValue<ByteParser>& val) const
 		{
-			return ContextRef.Global.get().ConvertLeaf(val);
+			return ContextRef.Global.get().ConvertLeaf(
+				string_view(val.data(), val.length()));
 		}
 		YB_ATTR_nodiscard TermNode
 		operator()(const GParsedValue<SourcedByteParser>& val) const
+		{
+			return ContextRef.Global.get().ConvertLeafSourced({val.first,
+				string_view(val.second.data(), val.second.length())},
+				ContextRef);
+		}
+		YB_ATTR_nodiscard TermNode
+		operator()(const GParsedValue<ViewByteParser>& val) const
+		{
+			return ContextRef.Global.get().ConvertLeaf(val);
+		}
+		YB_ATTR_nodiscard TermNode
+		operator()(const GParsedValue<SourcedViewByteParser>& val) const
 		{
 			return ContextRef.Global.get().ConvertLeafSourced(val, ContextRef);
 		}
 	};
 
+	// NOTE: The identifier of the last source name is cached.
+	mutable SourceName last_source{};
+	mutable size_t last_source_id = 0;
+
 public:
 	TermNode::allocator_type Allocator;
-	SeparatorPass Preprocess{Allocator};
+	// NOTE: If set, the arena of the temporary objects, which is rewound after
+	//	each reading and preprocessing.
+	observer_ptr<ArenaResource> ScratchArena;
+	// NOTE: The allocator for the temporary objects not kept after reading
+	//	and preprocessing.
+	TermNode::allocator_type ScratchAllocator;
+	mutable SymbolTable Symbols{Allocator};
+	SeparatorPass Preprocess{Symbols, Allocator, ScratchArena};
 	Tokenizer ConvertLeaf;
 	SourcedTokenizer ConvertLeafSourced;
 	bool UseSourceLocation = {};
+	// NOTE: If set, the source files are read through the cache.
+	observer_ptr<const TermImageCache> ImageCache{};
 
 	GlobalState(TermNode::allocator_type = {});
+	GlobalState(TermNode::allocator_type, observer_ptr<ArenaResource>);
+
+	YB_ATTR_nodiscard SourceTag
+	MakeSourceTag(const Context&, const SourceLocation&) const;
 
 	template<typename _tIn>
 	YB_ATTR_nodiscard TermNode
 	Prepare(LexicalAnalyzer& lexer, Context& ctx, _tIn first, _tIn last) const
 	{
-		ByteParser parse(lexer, Allocator);
+		ByteParser parse(lexer, ScratchAllocator);
 
 		return Prepare(ctx, first, last, ystdex::ref(parse));
 	}
@@ -1429,12 +1745,24 @@ public:
 	Prepare(Context& ctx, _tIn first, _tIn last, _fParse parse) const
 	{
 		std::for_each(first, last, parse);
+		return Prepare(ctx, parse);
+	}
+	template<typename _fParse>
+	YB_ATTR_nodiscard TermNode
+	Prepare(Context& ctx, _fParse parse) const
+	{
+		const auto& parse_result(ystdex::unref(parse).GetResult());
+
+		return PrepareLexemes(ctx, parse_result.cbegin(), parse_result.cend());
+	}
 
+	template<typename _tIn>
+	YB_ATTR_nodiscard TermNode
+	PrepareLexemes(Context& ctx, _tIn first, _tIn last) const
+	{
 		TermNode res{Allocator};
-		const auto& parse_result(ystdex::unref(parse).GetResult());
 
-		if(ReduceSyntax(res, parse_result.cbegin(), parse_result.cend(),
-			LeafConverter{ctx}) != parse_result.cend())
+		if(ReduceSyntax(res, first, last, LeafConverter{ctx}) != last)
 			throw UnilangException("Redundant ')', ']' or '}' found.");
 		return res;
 	}
@@ -1448,6 +1776,38 @@ public:
 	ReadFrom(std::istream&, Context&) const;
 };
 
+
+// NOTE: The reader of the top-level forms from the stream buffer. The forms
+//	are split at the top-level ';' as %SeparatorPass does, so each form can be
+//	evaluated before the remained input is read. The input without any
+//	top-level ';' is read as a whole, as %GlobalState::ReadFrom.
+// XXX: The parsers keep the buffers across the forms, so they do not use
+//	%GlobalState::ScratchAllocator, whose arena is rewound after each reading.
+class FormReader final
+{
+private:
+	lref<std::streambuf> buffer_ref;
+	LexicalAnalyzer lexer{};
+	ByteParser parse;
+	SourcedByteParser parse_sourced;
+	shared_ptr<string> source_name;
+	size_t depth = 0;
+	bool separated = {};
+
+public:
+	FormReader(std::streambuf&, Context&);
+	FormReader(const FormReader&) = delete;
+
+	FormReader&
+	operator=(const FormReader&) = delete;
+
+	// NOTE: The source name of the context is set to the name when the reader
+	//	is constructed. The result is unspecified if the reader is used with a
+	//	different global state.
+	YB_ATTR_nodiscard bool
+	Read(TermNode&, Context&);
+};
+
 } // namespace Unilang;
 
 #endif
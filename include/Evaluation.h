@@ -15,7 +15,8 @@
 //	HasValue;
 #include <iterator> // for std::make_move_iterator, std::next;
 #include <ystdex/algorithm.hpp> // for ystdex::split;
-#include "Parser.h" // for SourceLocation;
+#include "Parser.h" // for SourceLocation, SourceTag, SourceName;
+#include <ystdex/optional.h> // for ystdex::optional;
 #include <ystdex/operators.hpp> // for ystdex::equality_comparable;
 #include <ystdex/type_op.hpp> // for ystdex::exclude_self_params_t;
 #include <ystdex/function.hpp> // for ystdex::make_function_type_t,
@@ -119,11 +120,25 @@ struct SeparatorTransformer
 
 
 void
-ParseLeaf(TermNode&, string_view);
+ParseLeaf(TermNode&, SymbolTable&, string_view);
 
 void
-ParseLeafWithSourceInformation(TermNode&, string_view,
-	const shared_ptr<string>&, const SourceLocation&);
+ParseLeafWithSourceInformation(TermNode&, SymbolTable&, string_view,
+	const SourceTag&);
+
+void
+SetSourcedValue(TermNode&, const TokenValue&, const SourceTag&);
+void
+SetSourcedValue(TermNode&, string_view, const SourceTag&);
+
+// NOTE: The source names are registered in the process-wide table referenced
+//	by the source tags. Equal names have the same identifier, and the empty
+//	source name has the identifier 0.
+YB_ATTR_nodiscard size_t
+RegisterSourceName(const SourceName&);
+
+YB_ATTR_nodiscard SourceName
+QuerySourceName(size_t);
 
 
 template<typename _func>
@@ -308,7 +323,7 @@ public:
 	operator()(TermNode& term, Context& ctx) const
 	{
 		CheckArguments(wrapping, term);
-		return CallN(wrapping, term, ctx);
+		return call_n(*this, term, ctx);
 	}
 
 	YB_ATTR_nodiscard bool
@@ -704,7 +719,11 @@ NameTypedReducerHandler(_fCallable&& x, string_view desc)
 YB_ATTR_nodiscard YB_PURE string_view
 QueryContinuationName(const Reducer&);
 
-YB_ATTR_nodiscard YB_PURE const SourceInformation*
+YB_ATTR_nodiscard YB_PURE ystdex::optional<SourceTag>
+QuerySourceTag(const ValueObject&);
+
+// NOTE: The source name is resolved from the source tag on demand.
+YB_ATTR_nodiscard ystdex::optional<SourceInformation>
 QuerySourceInformation(const ValueObject&);
 
 YB_ATTR_nodiscard YB_PURE string_view
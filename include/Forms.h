@@ -435,6 +435,15 @@ EqLeaf(TermNode&);
 void
 EqValue(TermNode&);
 
+void
+EqualTerm(TermNode&);
+
+ReductionStatus
+Assq(TermNode&);
+
+ReductionStatus
+Assv(TermNode&);
+
 
 ReductionStatus
 If(TermNode&, Context&);
@@ -452,6 +461,12 @@ SetRest(TermNode&);
 void
 SetRestRef(TermNode&);
 
+ReductionStatus
+ListConcat(TermNode&);
+
+ReductionStatus
+Append(TermNode&);
+
 
 ReductionStatus
 Eval(TermNode&, Context&);
@@ -517,6 +532,12 @@ MakeEncapsulationType(TermNode& term);
 ReductionStatus
 Sequence(TermNode&, Context&);
 
+ReductionStatus
+While(TermNode&, Context&);
+
+ReductionStatus
+Until(TermNode&, Context&);
+
 
 ReductionStatus
 Call1CC(TermNode&, Context&);
@@ -5,7 +5,8 @@
 
 #include "Context.h" // for pair, lref, stack, vector, GlobalState, string,
 //	shared_ptr, Environment, Context, TermNode,
-//	YSLib::Logger, YSLib::unique_ptr, std::istream;
+//	YSLib::Logger, YSLib::unique_ptr, std::istream, FormReader, observer_ptr;
+#include "Memory.h" // for ArenaResource;
 #include <cstdlib> // for std::getenv;
 #include <ostream> // for std::ostream;
 
@@ -23,11 +24,14 @@ private:
 	shared_ptr<Environment> p_ground{};
 
 public:
-	GlobalState Global{};
+	GlobalState Global;
 	Context Main{Global};
 	TermNode Term{Global.Allocator};
 
-	Interpreter();
+	// NOTE: If the arena is set, it is used by the temporary objects in
+	//	reading and preprocessing the code. It shall outlive the interpreter.
+	Interpreter(TermNode::allocator_type = {},
+		observer_ptr<ArenaResource> = {});
 	Interpreter(const Interpreter&) = delete;
 
 	void
@@ -37,6 +41,10 @@ private:
 	ReductionStatus
 	ExecuteOnce(Context&);
 
+	ReductionStatus
+	ExecuteStream(Context&, const shared_ptr<std::istream>&,
+		const shared_ptr<FormReader>&);
+
 	ReductionStatus
 	ExecuteString(string_view, Context&);
 
@@ -59,12 +67,24 @@ public:
 	void
 	PrepareExecution(Context&);
 
+private:
+	void
+	PrepareEcho(Context&);
+
+	void
+	PrepareTrace(Context&);
+
+public:
+
 	static void
 	Print(const TermNode&);
 
 	YB_ATTR_nodiscard TermNode
 	Read(string_view);
 
+	YB_ATTR_nodiscard static TermNode
+	ReadFile(Context&, string);
+
 	void
 	Run();
 
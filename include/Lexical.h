@@ -6,6 +6,7 @@
 #include "Unilang.h" // for shared_ptr, pair, string_view;
 #include <cassert> // for assert;
 #include <ystdex/cctype.h> // for ystdex::isspace;
+#include <cstdint> // for std::uint64_t;
 
 namespace Unilang
 {
@@ -40,6 +41,58 @@ struct SourceLocation final
 using SourceInformation = pair<SourceName, SourceLocation>;
 
 
+// NOTE: The packed source information kept in the code. The source name is
+//	referenced by the identifier in the table of the source names. The values
+//	out of the ranges of the fields are saturated.
+class SourceTag final
+{
+public:
+	enum : size_t
+	{
+		IDBits = 20,
+		LineBits = 24,
+		ColumnBits = 20
+	};
+
+private:
+	std::uint64_t packed = 0;
+
+public:
+	SourceTag() = default;
+	SourceTag(size_t id, const SourceLocation& src_loc) noexcept
+		: packed(Saturate(id, IDBits) << (LineBits + ColumnBits)
+		| Saturate(src_loc.Line, LineBits) << ColumnBits
+		| Saturate(src_loc.Column, ColumnBits))
+	{}
+
+	YB_ATTR_nodiscard YB_PURE size_t
+	GetID() const noexcept
+	{
+		return size_t(packed >> (LineBits + ColumnBits));
+	}
+
+	YB_ATTR_nodiscard YB_PURE SourceLocation
+	GetLocation() const noexcept
+	{
+		return {size_t(packed >> ColumnBits & Mask(LineBits)),
+			size_t(packed & Mask(ColumnBits))};
+	}
+
+	YB_ATTR_nodiscard YB_STATELESS static std::uint64_t
+	Mask(size_t n) noexcept
+	{
+		return (std::uint64_t(1) << n) - 1;
+	}
+
+private:
+	YB_ATTR_nodiscard YB_STATELESS static std::uint64_t
+	Saturate(size_t val, size_t n) noexcept
+	{
+		return val < Mask(n) ? val : Mask(n);
+	}
+};
+
+
 class UnescapeContext final
 {
 public:
@@ -150,6 +203,21 @@ IsDelimiter(char c) noexcept
 	return ystdex::isspace(c) || IsGraphicalDelimiter(c);
 }
 
+YB_ATTR_nodiscard constexpr bool
+IsPlainCharacter(char c) noexcept
+{
+	return !(IsDelimiter(c) || c == '\'' || c == '"' || c == '\\');
+}
+
+// NOTE: The result of the following functions is the length of the longest
+//	prefix consisting of characters in the specified category. The callers
+//	append or skip the prefix as a whole.
+YB_ATTR_nodiscard YB_PURE size_t
+ScanPlainLength(string_view) noexcept;
+
+YB_ATTR_nodiscard YB_PURE size_t
+ScanSpaceLength(string_view) noexcept;
+
 
 enum class LexemeCategory
 {
@@ -0,0 +1,174 @@
+﻿// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co.,Ltd.
+
+#ifndef INC_Unilang_Memory_h_
+#define INC_Unilang_Memory_h_ 1
+
+#include "Unilang.h" // for size_t, pmr, lref, array, byte, observer_ptr;
+
+namespace Unilang
+{
+
+// NOTE: The statistics of the allocations from a memory resource. The
+//	upstream bytes are the bytes currently allocated from the upstream.
+struct AllocationStatistics final
+{
+	size_t Allocations = 0;
+	size_t Deallocations = 0;
+	size_t RequestedBytes = 0;
+	size_t UpstreamAllocations = 0;
+	size_t UpstreamBytes = 0;
+	size_t PeakUpstreamBytes = 0;
+
+	void
+	AddUpstream(size_t) noexcept;
+
+	void
+	RemoveUpstream(size_t) noexcept;
+};
+
+
+// NOTE: The pooled memory resource for the objects of small sizes. The blocks
+//	are in the size classes of the multiples of %Granularity not greater than
+//	%MaxBlockSize. Other requests are forwarded to the upstream. The memory in
+//	the pools is released only when the resource is destroyed. Like other
+//	resources here, it is not synchronized.
+class PoolResource final : public pmr::memory_resource
+{
+public:
+	enum : size_t
+	{
+		Granularity = 16,
+		MaxBlockSize = 512,
+		ClassCount = MaxBlockSize / Granularity
+	};
+
+private:
+	struct Chunk;
+	struct Pool final
+	{
+		void* FreeList = {};
+		byte* Current = {};
+		byte* End = {};
+		size_t NextCount = 16;
+	};
+
+	lref<pmr::memory_resource> upstream;
+	Chunk* p_chunks = {};
+	array<Pool, ClassCount> pools{};
+
+public:
+	AllocationStatistics Statistics{};
+
+	PoolResource(pmr::memory_resource&) noexcept;
+	PoolResource(const PoolResource&) = delete;
+	~PoolResource() override;
+
+	PoolResource&
+	operator=(const PoolResource&) = delete;
+
+private:
+	void*
+	do_allocate(size_t, size_t) override;
+
+	void
+	do_deallocate(void*, size_t, size_t) noexcept override;
+
+	YB_ATTR_nodiscard YB_PURE bool
+	do_is_equal(const memory_resource&) const noexcept override;
+};
+
+
+// NOTE: The monotonic memory resource for the temporary objects. The
+//	deallocation has no effect, and all the memory is reclaimed by %Reset. The
+//	largest chunk is kept on the reset for the later allocations. The memory
+//	allocated after a mark can also be reclaimed by %Rewind.
+class ArenaResource final : public pmr::memory_resource
+{
+public:
+	enum : size_t
+	{
+		InitialChunkSize = 4096,
+		MaxChunkSize = 1024 * 1024
+	};
+
+private:
+	struct Chunk;
+
+public:
+	struct Mark final
+	{
+		Chunk* ChunkPtr;
+		byte* Current;
+		byte* End;
+	};
+
+private:
+
+	lref<pmr::memory_resource> upstream;
+	Chunk* p_chunks = {};
+	byte* current = {};
+	byte* end = {};
+	size_t next_size = InitialChunkSize;
+
+public:
+	AllocationStatistics Statistics{};
+	size_t Rewinds = 0;
+
+	ArenaResource(pmr::memory_resource&) noexcept;
+	ArenaResource(const ArenaResource&) = delete;
+	~ArenaResource() override;
+
+	ArenaResource&
+	operator=(const ArenaResource&) = delete;
+
+	YB_ATTR_nodiscard YB_PURE Mark
+	GetMark() const noexcept
+	{
+		return {p_chunks, current, end};
+	}
+
+	// NOTE: All objects allocated from the resource after the mark shall have
+	//	been destroyed. The marks shall be rewound in the reversed order of
+	//	their creation.
+	void
+	Rewind(const Mark&) noexcept;
+
+private:
+	void*
+	do_allocate(size_t, size_t) override;
+
+	void
+	do_deallocate(void*, size_t, size_t) noexcept override;
+
+	YB_ATTR_nodiscard YB_PURE bool
+	do_is_equal(const memory_resource&) const noexcept override;
+};
+
+
+// NOTE: The guard to rewind the arena to the mark at the construction. No
+//	arena is rewound if the pointer is null.
+class ArenaRewindGuard final
+{
+private:
+	observer_ptr<ArenaResource> p_arena;
+	ArenaResource::Mark mark;
+
+public:
+	ArenaRewindGuard(observer_ptr<ArenaResource> p) noexcept
+		: p_arena(p), mark(p ? p->GetMark() : ArenaResource::Mark())
+	{}
+	ArenaRewindGuard(const ArenaRewindGuard&) = delete;
+	~ArenaRewindGuard()
+	{
+		if(p_arena)
+			p_arena->Rewind(mark);
+	}
+
+	ArenaRewindGuard&
+	operator=(const ArenaRewindGuard&) = delete;
+};
+
+} // namespace Unilang;
+
+#endif
+
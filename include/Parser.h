@@ -4,7 +4,7 @@
 #define INC_Unilang_Parser_h_ 1
 
 #include "Lexical.h" // for lref, LexicalAnalyzer, pmr::polymorphic_allocator,
-//	string, pmr, std::swap, vector;
+//	string, pmr, std::swap, vector, string_view, forward_list, assert;
 #include <ystdex/type_traits.hpp> // for ystdex::remove_reference_t;
 #include <ystdex/ref.hpp> // for ystdex::unwrap_ref_decay_t;
 #include <ystdex/meta.hpp> // for ystdex::detected_or_t,
@@ -137,6 +137,12 @@ public:
 		return lexemes;
 	}
 
+	void
+	ClearResult() noexcept
+	{
+		lexemes.clear();
+	}
+
 private:
 	void
 	Update(bool);
@@ -220,6 +226,12 @@ public:
 		return source_location;
 	}
 
+	void
+	ClearResult() noexcept
+	{
+		lexemes.clear();
+	}
+
 private:
 	void
 	Update(bool);
@@ -239,6 +251,213 @@ public:
 };
 
 
+class ViewByteParserBase : private BufferedByteParserBase
+{
+private:
+	string_view source;
+	size_t position = 0;
+	forward_list<string> literals;
+	bool sliced = {};
+
+public:
+	ViewByteParserBase(LexicalAnalyzer& lexer, string_view src,
+		pmr::polymorphic_allocator<yimpl(byte)> a = {})
+		: BufferedByteParserBase(lexer, a), source(src), literals(a)
+	{
+		assert(source.data());
+	}
+	ViewByteParserBase(ViewByteParserBase&&) = default;
+
+	ViewByteParserBase&
+	operator=(ViewByteParserBase&&) = default;
+
+	using BufferedByteParserBase::GetBackRef;
+	using BufferedByteParserBase::GetBuffer;
+	using BufferedByteParserBase::GetBufferRef;
+	using BufferedByteParserBase::GetLexerRef;
+	YB_ATTR_nodiscard YB_PURE size_t
+	GetPosition() const noexcept
+	{
+		return position;
+	}
+	YB_ATTR_nodiscard YB_PURE string_view
+	GetSource() const noexcept
+	{
+		return source;
+	}
+
+	void
+	AppendLexeme(string_view&, string_view);
+
+	YB_ATTR_nodiscard string_view
+	MakeLexeme(string_view);
+
+protected:
+	void
+	Skip(size_t n) noexcept
+	{
+		assert(!(source.length() - position < n)
+			&& "Invalid position found.");
+		position += n;
+	}
+
+	void
+	Step(char c) noexcept
+	{
+		yunused(c);
+		assert(position < source.length() && source[position] == c
+			&& "Invalid character found.");
+		++position;
+	}
+
+	YB_ATTR_nodiscard YB_PURE bool
+	IsScanningPlain() const noexcept
+	{
+		const auto& lexer(GetLexerRef());
+
+		return lexer.GetDelimiter() == char()
+			&& !lexer.GetUnescapeContext().IsHandling();
+	}
+
+	// NOTE: The plain runs are handled before the position is moved past the
+	//	last character of the run. See Parser.cpp for the definition.
+	template<typename _fPlain, typename _fSpace, typename _fChar>
+	void
+	ScanBlocks(_fPlain, _fSpace, _fChar);
+
+public:
+	using BufferedByteParserBase::reserve;
+};
+
+
+class ViewByteParser : private ViewByteParserBase
+{
+public:
+	using ParseResult = vector<string_view>;
+
+private:
+	mutable ParseResult lexemes{};
+	bool update_current = {};
+
+public:
+	ViewByteParser(LexicalAnalyzer& lexer, string_view src,
+		pmr::polymorphic_allocator<yimpl(byte)> a = {})
+		: ViewByteParserBase(lexer, src, a), lexemes(a)
+	{}
+	ViewByteParser(ViewByteParser&&) = default;
+
+	ViewByteParser&
+	operator=(ViewByteParser&&) = default;
+
+	void
+	operator()(char c)
+	{
+		auto& lexer(GetLexerRef());
+
+		Update(lexer.FilterChar(c, GetBufferRef())
+			&& lexer.UpdateBack(GetBackRef(), c));
+		Step(c);
+	}
+
+	bool
+	IsUpdating() const noexcept
+	{
+		return update_current;
+	}
+
+	using ViewByteParserBase::GetBuffer;
+	using ViewByteParserBase::GetBufferRef;
+	using ViewByteParserBase::GetLexerRef;
+	using ViewByteParserBase::GetPosition;
+	const ParseResult&
+	GetResult() const noexcept
+	{
+		return lexemes;
+	}
+	using ViewByteParserBase::GetSource;
+
+private:
+	void
+	Update(bool);
+
+public:
+	void
+	Scan();
+
+public:
+	using ViewByteParserBase::reserve;
+};
+
+
+class SourcedViewByteParser : private ViewByteParserBase
+{
+public:
+	using ParseResult = vector<pair<SourceLocation, string_view>>;
+
+private:
+	mutable ParseResult lexemes{};
+	bool update_current = {};
+	SourceLocation source_location{0, 0};
+
+public:
+	SourcedViewByteParser(LexicalAnalyzer& lexer, string_view src,
+		pmr::polymorphic_allocator<yimpl(byte)> a = {})
+		: ViewByteParserBase(lexer, src, a), lexemes(a)
+	{}
+	SourcedViewByteParser(SourcedViewByteParser&&) = default;
+
+	SourcedViewByteParser&
+	operator=(SourcedViewByteParser&&) = default;
+
+	void
+	operator()(char c)
+	{
+		auto& lexer(GetLexerRef());
+
+		Update(lexer.FilterChar(c, GetBufferRef())
+			&& lexer.UpdateBack(GetBackRef(), c));
+		Step(c);
+		if(c != '\n')
+			source_location.Step();
+		else
+			source_location.Newline();
+	}
+
+	bool
+	IsUpdating() const noexcept
+	{
+		return update_current;
+	}
+
+	using ViewByteParserBase::GetBuffer;
+	using ViewByteParserBase::GetBufferRef;
+	using ViewByteParserBase::GetLexerRef;
+	using ViewByteParserBase::GetPosition;
+	const ParseResult&
+	GetResult() const noexcept
+	{
+		return lexemes;
+	}
+	using ViewByteParserBase::GetSource;
+	const SourceLocation&
+	GetSourceLocation() const noexcept
+	{
+		return source_location;
+	}
+
+private:
+	void
+	Update(bool);
+
+public:
+	void
+	Scan();
+
+public:
+	using ViewByteParserBase::reserve;
+};
+
+
 template<class _type, yimpl(
 	typename = ystdex::enable_if_convertible_t<const _type&, const string&>)>
 YB_ATTR_nodiscard YB_STATELESS const _type&
@@ -251,6 +470,16 @@ ToLexeme(const SourcedByteParser::ParseResult::value_type& val) noexcept
 {
 	return val.second;
 }
+YB_ATTR_nodiscard YB_STATELESS inline string_view
+ToLexeme(string_view val) noexcept
+{
+	return val;
+}
+YB_ATTR_nodiscard YB_PURE inline string_view
+ToLexeme(const SourcedViewByteParser::ParseResult::value_type& val) noexcept
+{
+	return val.second;
+}
 
 } // namespace Unilang;
 
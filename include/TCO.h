@@ -6,6 +6,7 @@
 #include "Lexical.h" // for SourceName;
 #include "Evaluation.h" // for shared_ptr, Context, YSLib::allocate_shared,
 //	Unilang::Deref, UnilangException, unordered_map, lref, Environment, size_t, set,
+//	ParentKind, SingleWeakParent, SingleStrongParent, ParentList,
 //	weak_ptr, EnvironmentParent, IsTyped, pair, list, TermNode,
 //	EnvironmentGuard, ReductionStatus, NameTypedContextHandler;
 #include <ystdex/functor.hpp> // for ystdex::get_hash;
@@ -104,29 +105,37 @@ struct RecordCompressor final
 	YB_ATTR_nodiscard YB_PURE static size_t
 	CountStrong(const shared_ptr<Environment>&) noexcept;
 
+	// NOTE: The compression can collapse some parents only if the root is
+	//	reachable from its own parents. Otherwise, all environments traversed
+	//	from the root are reachable by the references from the root, so there
+	//	is nothing to compress. This checks the chain of single parents
+	//	without the allocation, and it is conservative for other cases.
+	YB_ATTR_nodiscard YB_PURE static bool
+	IsCompressible(const Environment&) noexcept;
+
 	template<typename _fTracer>
 	static void
 	Traverse(Environment& e, EnvironmentParent& parent, const _fTracer& trace)
 	{
-		const auto p_poly(&parent.GetObject());
- 
-		if(const auto p_single_weak
-			= dynamic_cast<const SingleWeakParent*>(p_poly))
+		const auto& poly(parent.GetObject());
+
+		switch(poly.GetKind())
 		{
-			if(auto p = p_single_weak->Get().Lock())
+		case ParentKind::SingleWeak:
+			if(auto p
+				= static_cast<const SingleWeakParent&>(poly).Get().Lock())
 				TraverseForSharedPtr(e, parent, trace, p);
-		}
-		else if(const auto p_single_strong
-			= dynamic_cast<const SingleStrongParent*>(p_poly))
-		{
-			if(auto p = p_single_strong->Get())
+			break;
+		case ParentKind::SingleStrong:
+			if(auto p = static_cast<const SingleStrongParent&>(poly).Get())
 				TraverseForSharedPtr(e, parent, trace, p);
-		}
-		else if(const auto p_parent_list
-			= dynamic_cast<const ParentList*>(p_poly))
-		{
-			for(auto& vo : p_parent_list->GetRef())
+			break;
+		case ParentKind::List:
+			for(auto& vo : static_cast<const ParentList&>(poly).GetRef())
 				Traverse(e, vo, trace);
+			break;
+		default:
+			break;
 		}
 	}
 
@@ -142,7 +151,7 @@ private:
 			auto& dst(Unilang::Deref(p));
 
 			p.reset();
-			Traverse(dst, dst.Parent, trace);
+			Traverse(dst, dst.parent, trace);
 		}
 	}
 };
@@ -287,7 +296,8 @@ public:
 	CompressForContext(Context& ctx)
 	{
 		CompressFrameList();
-		RecordCompressor(ctx.GetRecordPtr()).Compress();
+		if(RecordCompressor::IsCompressible(ctx.GetRecordRef()))
+			RecordCompressor(ctx.GetRecordPtr()).Compress();
 	}
 
 	void
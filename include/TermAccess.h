@@ -3,9 +3,9 @@
 #ifndef INC_Unilang_TermAccess_h_
 #define INC_Unilang_TermAccess_h_ 1
 
-#include "TermNode.h" // for string, TermNode, IsPair, YSLib::TryAccessValue,
-//	weak_ptr, AssertReferentTags, Unilang::IsMovable, PropagateTo, pair,
-//	Unilang::Deref;
+#include "TermNode.h" // for string, string_view, size_t, TermNode, IsPair,
+//	YSLib::TryAccessValue, weak_ptr, AssertReferentTags, Unilang::IsMovable,
+//	PropagateTo, pair, Unilang::Deref;
 #include "Exception.h" // for ThrowListTypeErrorForInvalidType;
 #include <ystdex/operators.hpp> // for ystdex::equality_comparable;
 #include <ystdex/type_op.hpp> // for ystdex::exclude_self_params_t;
@@ -13,35 +13,160 @@
 //	ystdex::enable_if_constructible_t;
 #include <ystdex/expanded_function.hpp> // for ystdex::expand_proxy;
 #include <ystdex/compose.hpp> // for ystdex::compose_n;
+#include <ystdex/functor.hpp> // for ystdex::plus, ystdex::multiplies;
+#include <new> // for placement ::operator new from standard library;
 
 namespace Unilang
 {
 
-// NOTE: The host type of symbol.
-class TokenValue final : public string
+YB_ATTR_nodiscard YB_PURE inline size_t
+HashSymbolName(string_view k) noexcept
 {
+	auto first(reinterpret_cast<const unsigned char*>(k.data()));
+	size_t h(5381);
+
+	for(auto n = k.size(); n != 0; --n)
+		h = size_t(ystdex::plus<>()(ystdex::multiplies<>()(h, size_t(65599)),
+			size_t(*first++)));
+	return h;
+}
+
+
+class SymbolTable;
+
+// NOTE: The host type of symbol. The value refers to the name interned in a
+//	%SymbolTable with the hash precomputed, so it can be only created by the
+//	table other than the copies. The name is always a NTCS.
+class TokenValue final
+	: public string_view, private ystdex::equality_comparable<TokenValue>
+{
+	friend class SymbolTable;
+
 public:
-	using base = string;
+	using base = string_view;
+
+private:
+	size_t hash;
 
-	TokenValue() = default;
-	using base::base;
-	TokenValue(const base& b)
-		: base(b)
+public:
+	TokenValue() noexcept
+		: base("", 0), hash(HashSymbolName({}))
 	{}
-	TokenValue(base&& b) noexcept
-		: base(std::move(b))
+
+private:
+	TokenValue(const string& name, size_t h) noexcept
+		: base(name.data(), name.size()), hash(h)
 	{}
+
+public:
 	TokenValue(const TokenValue&) = default;
-	TokenValue(TokenValue&&) = default;
 
 	TokenValue&
 	operator=(const TokenValue&) = default;
-	TokenValue&
-	operator=(TokenValue&&) = default;
+
+	// NOTE: Names interned in the same table are equal iff the addresses are
+	//	equal. Others are still compared by the contents.
+	YB_ATTR_nodiscard YB_PURE friend bool
+	operator==(const TokenValue& x, const TokenValue& y) noexcept
+	{
+		return x.data() == y.data()
+			|| (x.hash == y.hash && base(x) == base(y));
+	}
+
+	YB_ATTR_nodiscard YB_PURE size_t
+	GetHash() const noexcept
+	{
+		return hash;
+	}
 };
 
 
+// NOTE: The anchors are counted without synchronization if this is enabled.
+//	This is only safe when no environment is accessed by more than one
+//	thread, and it is for benchmarks.
+#ifndef Unilang_UseLocalAnchor
+#	define Unilang_UseLocalAnchor false
+#endif
+
+#if Unilang_UseLocalAnchor
+class LocalAnchorPtr final
+{
+private:
+	struct Block final
+	{
+		size_t Count;
+		lref<pmr::memory_resource> Resource;
+	};
+
+	Block* p_block = {};
+
+public:
+	LocalAnchorPtr() = default;
+	LocalAnchorPtr(std::nullptr_t) noexcept
+	{}
+	explicit
+	LocalAnchorPtr(pmr::memory_resource& r)
+		: p_block(::new(r.allocate(sizeof(Block), alignof(Block)))
+		Block{1, r})
+	{}
+	LocalAnchorPtr(const LocalAnchorPtr& ptr) noexcept
+		: p_block(ptr.p_block)
+	{
+		if(p_block)
+			++p_block->Count;
+	}
+	LocalAnchorPtr(LocalAnchorPtr&& ptr) noexcept
+		: p_block(ptr.p_block)
+	{
+		ptr.p_block = {};
+	}
+	~LocalAnchorPtr()
+	{
+		if(p_block && --p_block->Count == 0)
+			p_block->Resource.get().deallocate(p_block, sizeof(Block),
+				alignof(Block));
+	}
+
+	LocalAnchorPtr&
+	operator=(const LocalAnchorPtr& ptr) noexcept
+	{
+		auto tmp(ptr);
+
+		swap(tmp, *this);
+		return *this;
+	}
+	LocalAnchorPtr&
+	operator=(LocalAnchorPtr&& ptr) noexcept
+	{
+		auto tmp(std::move(ptr));
+
+		swap(tmp, *this);
+		return *this;
+	}
+
+	YB_ATTR_nodiscard YB_PURE explicit
+	operator bool() const noexcept
+	{
+		return p_block;
+	}
+
+	YB_ATTR_nodiscard YB_PURE long
+	use_count() const noexcept
+	{
+		return p_block ? long(p_block->Count) : 0L;
+	}
+
+	friend void
+	swap(LocalAnchorPtr& x, LocalAnchorPtr& y) noexcept
+	{
+		std::swap(x.p_block, y.p_block);
+	}
+};
+
+using AnchorPtr = LocalAnchorPtr;
+#else
 using AnchorPtr = shared_ptr<const void>;
+#endif
 
 static_assert(ystdex::is_nothrow_copy_constructible<AnchorPtr>(),
 	"Invalid type found.");
@@ -0,0 +1,51 @@
+﻿// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co.,Ltd.
+
+#ifndef INC_Unilang_TermImage_h_
+#define INC_Unilang_TermImage_h_ 1
+
+#include "Context.h" // for string, string_view, TermNode, Context;
+
+namespace Unilang
+{
+
+// NOTE: The binary image of the term trees read from the source, i.e. before
+//	the preprocessing. Only the values produced by the reader (symbols,
+//	strings, numbers, booleans and value tokens, with optional source
+//	locations) are supported. The symbols are interned on reading, and the
+//	source names are from the context as the reader.
+YB_ATTR_nodiscard bool
+WriteTermImage(string&, const TermNode&);
+
+YB_ATTR_nodiscard bool
+ReadTermImage(string_view&, TermNode&, Context&);
+
+
+// NOTE: The cache of the images of the source files in a directory. Each
+//	source file has an image file named by the hash of its path. An image is
+//	usable only if the format version, the path, the size and the hash of the
+//	content of the source file, and the use of the source information all
+//	match. The image does not depend on the build of the interpreter, so the
+//	format version shall be increased for any change of the trees produced by
+//	the reader.
+class TermImageCache final
+{
+private:
+	string directory;
+
+public:
+	TermImageCache(string_view dir, TermNode::allocator_type a = {})
+		: directory(dir.data(), dir.size(), a)
+	{}
+
+	// NOTE: The parameters are the name of the source file and its content.
+	//	The content hashed is the same to the content read when the image is
+	//	not usable, so the image never has the content different to the
+	//	hash. The failure to write the image is ignored.
+	YB_ATTR_nodiscard TermNode
+	Read(Context&, string, string_view) const;
+};
+
+} // namespace Unilang;
+
+#endif
+
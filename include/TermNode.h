@@ -129,6 +129,10 @@ private:
 		std::is_constructible<ValueObject, _tParams...>::value>;
 
 public:
+	// NOTE: The references to the subterms shall be kept valid across the
+	//	splicing and the moves of the containers, so the subterms are not
+	//	stored inline. Instead, the nodes allocated in order by the pooled
+	//	memory resource are adjacent.
 	using Container = list<TermNode>;
 	using allocator_type = Container::allocator_type;
 	using iterator = Container::iterator;
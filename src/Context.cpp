@@ -1,7 +1,8 @@
 ﻿// SPDX-FileCopyrightText: 2020-2023 UnionTech Software Technology Co.,Ltd.
 
 #include "Context.h" // for string_view, Unilang::allocate_shared,
-//	make_observer, lref, ystdex::retry_on_cond, YSLib::make_string_view;
+//	make_observer, lref, ystdex::retry_on_cond, YSLib::make_string_view,
+//	vector, ystdex::equal_to;
 #include <cassert> // for assert;
 #include "Exception.h" // for TypeError, BadIdentifier, UnilangException,
 //	ListTypeError;
@@ -13,10 +14,13 @@
 #include <ystdex/scope_guard.hpp> // for ystdex::make_guard;
 #include "TermAccess.h" // for Unilang::IsMovable;
 #include "Forms.h" // for Forms::Sequence, ReduceBranchToList;
-#include "Evaluation.h" // for Strict;
+#include "Evaluation.h" // for Strict, RegisterSourceName;
 #include <ystdex/functor.hpp> // for ystdex::id;
-#include <algorithm> // for std::find_if;
+#include <algorithm> // for std::lower_bound;
 #include "Syntax.h" // for ReduceSyntax;
+#include <iterator> // for std::prev, std::distance, std::next;
+#include <cstdint> // for std::uintptr_t;
+#include <atomic> // for std::atomic, std::memory_order_relaxed;
 
 namespace Unilang
 {
@@ -29,6 +33,7 @@ EnvironmentReference::EnvironmentReference(const shared_ptr<Environment>& p_env)
 namespace
 {
 
+#if !Unilang_UseLocalAnchor
 struct AnchorData final
 {
 public:
@@ -38,6 +43,7 @@ public:
 	AnchorData&
 	operator=(AnchorData&&) = default;
 };
+#endif
 
 
 shared_ptr<Environment>
@@ -74,6 +80,76 @@ RedirectEnvironmentList(Environment::allocator_type a, Redirector& cont,
 	}, std::move(cont)));
 }
 
+YB_ATTR_nodiscard bool
+RedirectParent(shared_ptr<Environment>& p_env, Redirector& cont)
+{
+	observer_ptr<const IParent> p_next(&p_env->GetParent().GetObject());
+
+	do
+	{
+		auto& parent(*p_next);
+
+		p_next = {};
+		if(auto p_redirected = parent.TryRedirect(cont))
+		{
+			p_env.swap(p_redirected);
+			return true;
+		}
+		while(!p_next && bool(cont))
+			p_next = ystdex::exchange(cont, Redirector())();
+		assert(p_next.get() != &parent && "Cyclic parent found.");
+	}while(p_next);
+	return {};
+}
+
+YB_ATTR_nodiscard YB_PURE bool
+IsSingleParent(const EnvironmentParent& parent) noexcept
+{
+	const auto kind(parent.GetObject().GetKind());
+
+	return kind == ParentKind::SingleWeak || kind == ParentKind::SingleStrong;
+}
+
+// NOTE: This is same to %RedirectParent for the parent of a single
+//	environment, except that the result is empty for other parents.
+YB_ATTR_nodiscard shared_ptr<Environment>
+LockSingleParent(const Environment& env) noexcept
+{
+	const auto& poly(env.GetParent().GetObject());
+
+	switch(poly.GetKind())
+	{
+	case ParentKind::SingleWeak:
+		return static_cast<const SingleWeakParent&>(poly).Get().Lock();
+	case ParentKind::SingleStrong:
+		return static_cast<const SingleStrongParent&>(poly).Get();
+	default:
+		return {};
+	}
+}
+
+template<typename _tKey>
+YB_ATTR_nodiscard NameResolution
+ResolveWith(shared_ptr<Environment> p_env, const _tKey& id, Redirector& cont)
+{
+	assert(bool(p_env));
+
+	NameResolution::first_type p_obj;
+
+	do
+		p_obj = p_env->LookupName(id);
+	while(!p_obj && RedirectParent(p_env, cont));
+	return {p_obj, std::move(p_env)};
+}
+template<typename _tKey>
+YB_ATTR_nodiscard NameResolution
+ResolveWith(shared_ptr<Environment> p_env, const _tKey& id)
+{
+	Redirector cont;
+
+	return ResolveWith(std::move(p_env), id, cont);
+}
+
 YB_NORETURN void
 ThrowResolveEnvironmentFailure(const TermNode& term, bool has_ref)
 {
@@ -81,9 +157,96 @@ ThrowResolveEnvironmentFailure(const TermNode& term, bool has_ref)
 		" found.", TermToStringWithReferenceMark(term, has_ref).c_str()));
 }
 
+void
+SetTopLevelForm(TermNode& term, TermNode&& res)
+{
+	// NOTE: This is consistent to %SeparatorTransformer.
+	if(res.size() == 1)
+		term = std::move(*res.begin());
+	else
+		term = std::move(res);
+}
+
+template<class _tParser>
+YB_ATTR_nodiscard bool
+ReadTopLevelForm(std::streambuf& buf, _tParser& parse, size_t& depth,
+	bool& separated, TermNode& term, Context& ctx)
+{
+	using traits_type = std::streambuf::traits_type;
+	const auto& global(ctx.Global.get());
+	const auto& lexemes(parse.GetResult());
+
+	for(auto c(buf.sbumpc()); !traits_type::eq_int_type(c, traits_type::eof());
+		c = buf.sbumpc())
+	{
+		const auto n(lexemes.size());
+
+		parse(traits_type::to_char_type(c));
+		// NOTE: The graphical delimiters are always added as single lexemes
+		//	and never appended later.
+		if(lexemes.size() != n)
+		{
+			const auto& lexeme(ToLexeme(lexemes.back()));
+
+			if(lexeme == "(" || lexeme == "[" || lexeme == "{")
+				++depth;
+			else if(lexeme == ")" || lexeme == "]" || lexeme == "}")
+			{
+				if(depth != 0)
+					--depth;
+			}
+			else if(lexeme == ";" && depth == 0)
+			{
+				auto res(global.PrepareLexemes(ctx, lexemes.cbegin(),
+					std::prev(lexemes.cend())));
+
+				parse.ClearResult();
+				separated = true;
+				if(IsBranch(res))
+				{
+					SetTopLevelForm(term, std::move(res));
+					return true;
+				}
+			}
+		}
+	}
+	if(!lexemes.empty())
+	{
+		auto res(global.PrepareLexemes(ctx, lexemes.cbegin(),
+			lexemes.cend()));
+
+		parse.ClearResult();
+		if(!separated)
+		{
+			term = std::move(res);
+			return true;
+		}
+		if(IsBranch(res))
+		{
+			SetTopLevelForm(term, std::move(res));
+			return true;
+		}
+	}
+	return {};
+}
+
 } // unnamed namespace;
 
 
+TokenValue
+SymbolTable::Intern(string_view id)
+{
+	assert(id.data());
+
+	auto i(names.find(id));
+
+	if(i == names.end())
+		i = names.emplace(string(id.data(), id.size(), names.get_allocator()),
+			HashSymbolName(id)).first;
+	return TokenValue(i->first, i->second);
+}
+
+
 IParent::~IParent() = default;
 
 
@@ -143,13 +306,103 @@ Environment::EnsureValid(const shared_ptr<Environment>& p_env)
 AnchorPtr
 Environment::InitAnchor(allocator_type a) const
 {
+#if Unilang_UseLocalAnchor
+	return AnchorPtr(Unilang::Deref(a.resource()));
+#else
 	return Unilang::allocate_shared<AnchorData>(a);
+#endif
+}
+
+size_t
+Environment::AllocateCacheSerial() noexcept
+{
+	// NOTE: The environments can be created in different threads.
+	static std::atomic<size_t> serial(0);
+
+	return serial.fetch_add(1, std::memory_order_relaxed);
+}
+
+void
+Environment::FreezeIndexed()
+{
+	size_t n(2);
+
+	while(n < bindings.size() * 2)
+		n <<= 1;
+
+	vector<IndexEntry> idx(n, IndexEntry{0, nullptr});
+	const auto mask(n - 1);
+
+	for(auto& pr : bindings)
+	{
+		const auto h(bindings.hash_function()(pr.first));
+		auto i(h & mask);
+
+		while(idx[i].Binding)
+			i = (i + 1) & mask;
+		idx[i] = {h, &pr};
+	}
+	Freeze();
+	index = std::move(idx);
+}
+
+void
+Environment::IndexFrame() noexcept
+{
+	if(bindings.size() <= frame.size())
+	{
+		frame_size = 0;
+		for(auto& pr : bindings)
+			frame[frame_size++] = {bindings.hash_function()(pr.first), &pr};
+	}
+}
+
+template<typename _tKey>
+NameResolution::first_type
+Environment::LookupIndexed(const _tKey& id, size_t h) const
+{
+	if(HasFrame())
+	{
+		for(size_t i(0); i != frame_size; ++i)
+		{
+			const auto& entry(frame[i]);
+
+			if(entry.Hash == h
+				&& ystdex::equal_to<>()(entry.Binding->first, id))
+				return make_observer(&entry.Binding->second);
+		}
+		return {};
+	}
+
+	const auto mask(index.size() - 1);
+
+	for(auto i(h & mask); ; i = (i + 1) & mask)
+	{
+		const auto& entry(index[i]);
+
+		if(!entry.Binding)
+			return {};
+		if(entry.Hash == h && ystdex::equal_to<>()(entry.Binding->first, id))
+			return make_observer(&entry.Binding->second);
+	}
 }
 
 NameResolution::first_type
 Environment::LookupName(string_view id) const
 {
 	assert(id.data());
+	if(HasFrame() || !index.empty())
+		return LookupIndexed(id, bindings.hash_function()(id));
+
+	const auto i(bindings.find(id));
+
+	return make_observer(i != bindings.cend() ? &i->second : nullptr);
+}
+NameResolution::first_type
+Environment::LookupName(const TokenValue& id) const
+{
+	if(HasFrame() || !index.empty())
+		return LookupIndexed(id, id.GetHash());
 
 	const auto i(bindings.find(id));
 
@@ -164,9 +417,108 @@ Environment::ThrowForInvalidType(const type_info& tp)
 }
 
 
+NameResolution
+ResolutionCache::Resolve(shared_ptr<Environment> p_env, const TokenValue& id)
+{
+	assert(bool(p_env));
+
+	const auto p_key(p_env.get());
+	const auto serial(p_key->GetCacheSerial());
+	auto& entry(entries[((reinterpret_cast<std::uintptr_t>(p_key) >> 4)
+		^ id.GetHash()) % entries.size()]);
+
+	if(entry.Depth != 0 && entry.Key == p_key && entry.Name == id.data()
+		&& entry.KeySerial == serial
+		&& entry.Steps[0].Version == p_key->GetCacheVersion())
+	{
+		auto p_found(p_env);
+		size_t i(1);
+
+		// NOTE: The pointer is compared before the access to the version, so
+		//	the null pointer from an expired parent is not accessed.
+		for(; i != entry.Depth; ++i)
+		{
+			p_found = LockSingleParent(*p_found);
+			if(!(p_found.get() == entry.Steps[i].Pointer
+				&& p_found->GetCacheVersion() == entry.Steps[i].Version))
+				break;
+		}
+		if(i == entry.Depth)
+			return {entry.Object, std::move(p_found)};
+	}
+
+	Redirector cont;
+	array<Step, MaxDepth> steps{};
+	size_t depth(0);
+	bool single = true;
+	NameResolution::first_type p_obj;
+
+	while(true)
+	{
+		if(depth < MaxDepth)
+			steps[depth] = {p_env.get(), p_env->GetCacheVersion()};
+		++depth;
+		p_obj = p_env->LookupName(id);
+		if(p_obj)
+			break;
+		single = single && IsSingleParent(p_env->GetParent());
+		if(!RedirectParent(p_env, cont))
+			break;
+	}
+	if(p_obj && single && depth <= MaxDepth)
+	{
+		entry.Key = p_key;
+		entry.KeySerial = serial;
+		entry.Name = id.data();
+		entry.Object = p_obj;
+		entry.Depth = depth;
+		entry.Steps = std::move(steps);
+	}
+	return {p_obj, std::move(p_env)};
+}
+
+
 Context::Context(const GlobalState& g)
 	: memory_rsrc(*g.Allocator.resource()), Global(g)
-{}
+{
+	recycled.reserve(64);
+}
+
+shared_ptr<Environment>
+Context::AllocateFreshEnvironment()
+{
+	const auto a(GetRecordRef().GetMap().get_allocator());
+	auto p_env(Unilang::AllocateEnvironment(a));
+
+	if(!recycled.empty() && recycled.back().get_allocator() == a)
+	{
+		p_env->GetMapUncheckedRef() = std::move(recycled.back());
+		recycled.pop_back();
+	}
+	return p_env;
+}
+
+void
+Context::RecycleEnvironment(shared_ptr<Environment>& p_env) noexcept
+{
+	const BindingMap::allocator_type a(&memory_rsrc.get());
+
+	if(p_env && p_env.use_count() == 1 && p_env->IsOrphan()
+		&& recycled.size() < recycled.capacity()
+		&& p_env->GetMap().get_allocator() == a)
+	{
+		BindingMap m(std::move(p_env->GetMapUncheckedRef()));
+
+		// NOTE: The environment is destroyed before the bindings, so it is
+		//	not accessible by the weak references when the bindings are
+		//	destroyed.
+		p_env.reset();
+		// NOTE: Destroying the bindings may recycle other environments.
+		m.clear();
+		if(recycled.size() < recycled.capacity())
+			recycled.push_back(std::move(m));
+	}
+}
 
 TermNode&
 Context::GetNextTermRef() const
@@ -181,7 +533,18 @@ Context::ApplyTail()
 {
 	assert(IsAlive() && "No tail action found.");
 	TailAction = std::move(current.front());
-	current.pop_front();
+	// NOTE: The node is stashed to be reused by %SetupFront without the
+	//	allocation. The number of the stashed nodes is limited to keep the
+	//	memory used by deep recursions from being retained.
+	if(stashed_size < 1024U)
+	{
+		current.front() = Reducer();
+		stashed.splice_after(stashed.cbefore_begin(), current,
+			current.cbefore_begin());
+		++stashed_size;
+	}
+	else
+		current.pop_front();
 	try
 	{
 		LastStatus = TailAction(*this);
@@ -210,38 +573,25 @@ Context::DefaultHandleException(std::exception_ptr p)
 
 NameResolution
 Context::Resolve(shared_ptr<Environment> p_env, string_view id) const
+{
+	return ResolveWith(std::move(p_env), id);
+}
+NameResolution
+Context::Resolve(shared_ptr<Environment> p_env, const TokenValue& id) const
 {
 	assert(bool(p_env));
+	if(const auto p_obj = p_env->LookupName(id))
+		return {p_obj, std::move(p_env)};
 
 	Redirector cont;
-	NameResolution::first_type p_obj;
-
-	do
-	{
-		p_obj = p_env->LookupName(id);
-	}while([&]() -> bool{
-		if(!p_obj)
-		{
-			observer_ptr<const IParent> p_next(&p_env->Parent.GetObject());
-
-			do
-			{
-				auto& parent(*p_next);
 
-				p_next = {};
-				if(auto p_redirected = parent.TryRedirect(cont))
-				{
-					p_env.swap(p_redirected);
-					return true;
-				}
-				while(!p_next && bool(cont))
-					p_next = ystdex::exchange(cont, Redirector())();
-				assert(p_next.get() != &parent && "Cyclic parent found.");
-			}while(p_next);
-		}
-		return false;
-	}());
-	return {p_obj, std::move(p_env)};
+	// NOTE: The fresh environments of the calls are not cached. The
+	//	resolution is cached from the parent only if there is nothing else to
+	//	be redirected later.
+	if(RedirectParent(p_env, cont))
+		return cont ? ResolveWith(std::move(p_env), id, cont)
+			: resolution_cache.Resolve(std::move(p_env), id);
+	return {{}, std::move(p_env)};
 }
 
 ReductionStatus
@@ -429,54 +779,146 @@ struct SeparatorPass::TransformationSpec final
 		BinaryAssocRight
 	};
 
-	function<bool(const TermNode&)> Filter;
+	vector<TokenValue> Tokens;
 	function<ValueObject(const ValueObject&)> MakePrefix;
 	SeparatorKind Kind;
 
-	TransformationSpec(decltype(Filter), decltype(MakePrefix),
+	TransformationSpec(vector<TokenValue>, decltype(MakePrefix),
 		SeparatorKind = NAry);
-	TransformationSpec(TokenValue, ValueObject, SeparatorKind = NAry);
+	TransformationSpec(const TokenValue&, ValueObject, SeparatorKind = NAry);
 };
 
-SeparatorPass::TransformationSpec::TransformationSpec(
-	decltype(Filter) filter, decltype(MakePrefix) make_pfx, SeparatorKind kind)
-	: Filter(std::move(filter)), MakePrefix(std::move(make_pfx)), Kind(kind)
+SeparatorPass::TransformationSpec::TransformationSpec(vector<TokenValue> toks,
+	decltype(MakePrefix) make_pfx, SeparatorKind kind)
+	: Tokens(std::move(toks)), MakePrefix(std::move(make_pfx)), Kind(kind)
 {}
-SeparatorPass::TransformationSpec::TransformationSpec(TokenValue delim,
+SeparatorPass::TransformationSpec::TransformationSpec(const TokenValue& delim,
 	ValueObject pfx, SeparatorKind kind)
-	: TransformationSpec(ystdex::bind1(HasValue<TokenValue>, delim),
-		[=](const ValueObject&){
+	: TransformationSpec({delim}, [=](const ValueObject&){
 		return pfx;
 	}, kind)
 {}
 
-SeparatorPass::SeparatorPass(TermNode::allocator_type a)
-	: allocator(a), transformations({{";", ContextHandler(Forms::Sequence)},
-	{",", ContextHandler(FormContextHandler(ReduceBranchToList, Strict))},
-	{[](const TermNode& nd) noexcept{
-		return HasValue<TokenValue>(nd, ":=");
-	}, [](const ValueObject&){
-		return TokenValue("assign!");
-	}, TransformationSpec::BinaryAssocRight},
-	{[](const TermNode& nd) noexcept{
-		return HasValue<TokenValue>(nd, "=") || HasValue<TokenValue>(nd, "!=");
-	}, ystdex::id<>(), TransformationSpec::BinaryAssocLeft},
-	{[](const TermNode& nd) noexcept{
-		return HasValue<TokenValue>(nd, "<") || HasValue<TokenValue>(nd, ">")
-			|| HasValue<TokenValue>(nd, "<=") || HasValue<TokenValue>(nd, ">=");
-	}, ystdex::id<>(), TransformationSpec::BinaryAssocLeft},
-	{[](const TermNode& nd) noexcept{
-		return HasValue<TokenValue>(nd, "+") || HasValue<TokenValue>(nd, "-"); 
-	}, ystdex::id<>(), TransformationSpec::BinaryAssocLeft},
-	{[](const TermNode& nd) noexcept{
-		return HasValue<TokenValue>(nd, "*") || HasValue<TokenValue>(nd, "/"); 
-	}, ystdex::id<>(), TransformationSpec::BinaryAssocLeft}}, a)
-{}
+
+struct SeparatorPass::Layout final
+{
+	// NOTE: The low bits of the code of an item are the index of the
+	//	transformation matching the item. The highest bit is set for the
+	//	items created by the transformations.
+	enum : unsigned char
+	{
+		IndexedSize = 16,
+		NoTransformation = 0x7F,
+		CreatedItem = 0x80
+	};
+
+	vector<unsigned char> Codes;
+	// NOTE: Only the layouts larger than %IndexedSize have the sorted
+	//	positions of the items for each transformation. Others are searched
+	//	linearly.
+	vector<vector<size_t>> Positions;
+
+	YB_ATTR_nodiscard YB_PURE size_t
+	GetIndex(size_t i) const noexcept
+	{
+		return Codes[i] & NoTransformation;
+	}
+
+	YB_ATTR_nodiscard YB_PURE bool
+	IsCreated(size_t i) const noexcept
+	{
+		return Codes[i] & CreatedItem;
+	}
+
+	// NOTE: The result is the first and the last positions of the items
+	//	matching the transformation in the range, or a pair of the end of the
+	//	range if not found.
+	YB_ATTR_nodiscard YB_PURE pair<size_t, size_t>
+	Find(size_t n, size_t first, size_t last) const noexcept
+	{
+		if(!Positions.empty())
+		{
+			const auto& pos(Positions[n]);
+			const auto i(std::lower_bound(pos.cbegin(), pos.cend(), first));
+			const auto j(std::lower_bound(i, pos.cend(), last));
+
+			if(i != j)
+				return {*i, *std::prev(j)};
+		}
+		else
+		{
+			auto i(first);
+
+			while(i != last && GetIndex(i) != n)
+				++i;
+			if(i != last)
+			{
+				auto j(last - 1);
+
+				while(GetIndex(j) != n)
+					--j;
+				return {i, j};
+			}
+		}
+		return {last, last};
+	}
+};
+
+
+struct SeparatorPass::WorkItem final
+{
+	lref<TermNode> Term;
+	lref<const Layout> LayoutRef;
+	size_t First;
+	size_t Last;
+	bool SkipBinary;
+};
+
+
+struct SeparatorPass::WorkList final
+{
+	forward_list<Layout> Layouts;
+	vector<WorkItem> Items;
+	// NOTE: The created subterms are pending until the items containing them
+	//	are finished, since the binary transformations are skipped depending
+	//	on the enclosing subterms.
+	unordered_map<const TermNode*, WorkItem> Parts;
+
+	WorkList(TermNode::allocator_type a)
+		: Layouts(a), Items(a), Parts(a)
+	{}
+};
+
+
+SeparatorPass::SeparatorPass(SymbolTable& symbols,
+	TermNode::allocator_type a, observer_ptr<ArenaResource> p_arena)
+	: allocator(a), scratch_arena(p_arena),
+	scratch_allocator(p_arena ? TermNode::allocator_type(p_arena.get()) : a),
+	transformations({{symbols.Intern(";"), ContextHandler(Forms::Sequence)},
+	{symbols.Intern(","),
+	ContextHandler(FormContextHandler(ReduceBranchToList, Strict))},
+	{symbols.Intern(":="), symbols.Intern("assign!"),
+	TransformationSpec::BinaryAssocRight},
+	{{symbols.Intern("="), symbols.Intern("!=")}, ystdex::id<>(),
+	TransformationSpec::BinaryAssocLeft},
+	{{symbols.Intern("<"), symbols.Intern(">"), symbols.Intern("<="),
+	symbols.Intern(">=")}, ystdex::id<>(),
+	TransformationSpec::BinaryAssocLeft},
+	{{symbols.Intern("+"), symbols.Intern("-")}, ystdex::id<>(),
+	TransformationSpec::BinaryAssocLeft},
+	{{symbols.Intern("*"), symbols.Intern("/")}, ystdex::id<>(),
+	TransformationSpec::BinaryAssocLeft}}, a)
+{
+	assert(transformations.size() < Layout::NoTransformation
+		&& "Too many transformations found.");
+}
 SeparatorPass::~SeparatorPass() = default;
 
 ReductionStatus
 SeparatorPass::operator()(TermNode& term) const
 {
+	const ArenaRewindGuard gd(scratch_arena);
+
 	assert(remained.empty() && "Invalid state found.");
 	Transform(term, {}, remained);
 	while(!remained.empty())
@@ -484,127 +926,300 @@ SeparatorPass::operator()(TermNode& term) const
 		const auto entry(std::move(remained.top()));
 
 		remained.pop();
-		for(auto& tm : entry.first.get())
-			Transform(tm, entry.second, remained);
+		Transform(entry.first, entry.second, remained);
 	}
 	return ReductionStatus::Clean;
 }
 
+unsigned char
+SeparatorPass::Classify(const TermNode& nd) const noexcept
+{
+	if(const auto p = nd.Value.AccessPtr<TokenValue>())
+		for(size_t n(0); n != transformations.size(); ++n)
+			for(const auto& tok : transformations[n].Tokens)
+				if(*p == tok)
+					return static_cast<unsigned char>(n);
+	return Layout::NoTransformation;
+}
+
+SeparatorPass::Layout
+SeparatorPass::MakeLayout(vector<unsigned char>&& codes) const
+{
+	const auto a(codes.get_allocator());
+	Layout res{std::move(codes), vector<vector<size_t>>(a)};
+
+	if(res.Codes.size() > Layout::IndexedSize)
+	{
+		res.Positions.resize(transformations.size());
+		for(size_t i(0); i != res.Codes.size(); ++i)
+		{
+			const auto n(res.GetIndex(i));
+
+			if(n != Layout::NoTransformation)
+				res.Positions[n].push_back(i);
+		}
+	}
+	return res;
+}
+
 void
 SeparatorPass::Transform(TermNode& term, bool skip_binary,
 	SeparatorPass::TermStack& terms) const
 {
 	if(IsBranch(term))
 	{
-		if(IsEmpty(*term.begin()))
-			skip_binary = true;
-		terms.push({term, skip_binary});
-		for(const auto& trans : transformations)
+		auto i(term.begin());
+
+		while(i != term.end() && Classify(*i) == Layout::NoTransformation)
+			++i;
+		if(i != term.end())
 		{
-			const auto& filter(trans.Filter);
-			auto i(std::find_if(term.begin(), term.end(), filter));
+			vector<unsigned char> codes(size_t(std::distance(term.begin(), i)),
+				Layout::NoTransformation, scratch_allocator);
+			WorkList work(scratch_allocator);
+
+			codes.reserve(term.size());
+			for(; i != term.end(); ++i)
+				codes.push_back(Classify(*i));
+			work.Layouts.push_front(MakeLayout(std::move(codes)));
+			work.Items.push_back({term, work.Layouts.front(), 0, term.size(),
+				skip_binary});
+			// NOTE: The created subterms are transformed here with the
+			//	classification of their items, which are never classified
+			//	again.
+			while(!work.Items.empty())
+			{
+				const auto item(work.Items.back());
+
+				work.Items.pop_back();
+				TransformItem(item, work, terms);
+			}
+		}
+		else
+		{
+			if(IsEmpty(*term.begin()))
+				skip_binary = true;
+			for(auto& sub : term)
+				if(IsBranch(sub))
+					terms.push({sub, skip_binary});
+		}
+	}
+}
+
+void
+SeparatorPass::TransformItem(const WorkItem& item, WorkList& work,
+	TermStack& terms) const
+{
+	auto& term(item.Term.get());
+	auto& con(term.GetContainerRef());
+	const auto a(term.get_allocator());
+	const bool skip_binary(item.SkipBinary || IsEmpty(*term.begin()));
+	auto p_layout(&item.LayoutRef.get());
+	auto first(item.First), last(item.Last);
+
+	assert(con.size() == last - first && "Invalid layout found.");
+	for(size_t n(0); n != transformations.size(); ++n)
+	{
+		const auto& layout(*p_layout);
+		const auto found(layout.Find(n, first, last));
+
+		if(found.first == last)
+			continue;
+
+		const auto& trans(transformations[n]);
+		TermNode::Container res(a);
+		vector<unsigned char> codes(scratch_allocator);
+		// NOTE: The items in the range are added as a single subterm, or as a
+		//	new subterm transformed later with the same layout.
+		const auto add_part([&](TermNode::Container& part, size_t b, size_t e){
+			if(e - b == 1)
+			{
+				res.splice(res.end(), part);
+				codes.push_back(layout.Codes[b]);
+			}
+			else if(e != b)
+			{
+				res.push_back(Unilang::AsTermNode(a));
+
+				auto& sub(res.back());
 
-			if(i != term.end())
-				switch(trans.Kind)
+				sub.GetContainerRef().swap(part);
+				codes.push_back(
+					Layout::NoTransformation | Layout::CreatedItem);
+				work.Parts.emplace(&sub, WorkItem{sub, layout, b, e, {}});
+			}
+		});
+
+		switch(trans.Kind)
+		{
+		case TransformationSpec::NAry:
+		{
+			auto i(con.begin());
+			ValueObject pfx;
+
+			// NOTE: The code of the prefix is set later.
+			codes.push_back(Layout::NoTransformation);
+			for(size_t b(first), k(first); k != last; ++k)
+			{
+				const auto j(i++);
+
+				if(layout.GetIndex(k) == n)
 				{
-				case TransformationSpec::NAry:
-					term = SeparatorTransformer::Process(std::move(term),
-						trans.MakePrefix(i->Value), filter);
-					break;
-				case TransformationSpec::BinaryAssocLeft:
-				case TransformationSpec::BinaryAssocRight:
-					if(skip_binary)
-						break;
-					if(trans.Kind == TransformationSpec::BinaryAssocLeft)
-					{
-						const auto ri(std::find_if(term.rbegin(), term.rend(),
-							filter));
-
-						assert(ri != term.rend());
-						i = ri.base();
-						--i;
-					}
-					if(i != term.begin() && std::next(i) != term.end())
-					{
-						const auto a(term.get_allocator());
-						auto res(Unilang::AsTermNode(a, yforward(term).Value));
-						auto im(std::make_move_iterator(i));
-						using it_t = decltype(im);
-						const auto range_add([&](it_t b, it_t e){
-							const auto add([&](TermNode& node, it_t j){
-								node.Add(Unilang::Deref(j));
-							});
-
-							assert(b != e);
-							if(std::next(b) == e)
-								add(res, b);
-							else
-							{
-								auto child(Unilang::AsTermNode(a));
-
-								do
-								{
-									add(child, b++);
-								}while(b != e);
-								res.Add(std::move(child));
-							}
-						});
-
-						res.Add(
-							Unilang::AsTermNode(a, trans.MakePrefix(i->Value)));
-						range_add(std::make_move_iterator(term.begin()), im);
-						range_add(++im, std::make_move_iterator(term.end()));
-						term = std::move(res);
-					}
+					TermNode::Container part(a);
+
+					if(k == found.first)
+						pfx = trans.MakePrefix(j->Value);
+					part.splice(part.end(), con, con.begin(), j);
+					add_part(part, b, k);
+					con.pop_front();
+					b = k + 1;
 				}
+				if(k + 1 == last)
+					add_part(con, b, last);
+			}
+			res.push_front(Unilang::AsTermNode(a, std::move(pfx)));
+			codes.front() = Classify(res.front()) | Layout::CreatedItem;
+			break;
+		}
+		case TransformationSpec::BinaryAssocLeft:
+		case TransformationSpec::BinaryAssocRight:
+		{
+			if(skip_binary)
+				continue;
+
+			const auto p(trans.Kind == TransformationSpec::BinaryAssocLeft
+				? found.second : found.first);
+
+			if(p == first || p + 1 == last)
+				continue;
+
+			// NOTE: The operator is found from the nearer end, and only the
+			//	smaller side is relinked to a new container.
+			const auto i_op(p - first <= last - p ? std::next(con.begin(),
+				std::ptrdiff_t(p - first))
+				: std::prev(con.end(), std::ptrdiff_t(last - p)));
+			const auto i_right(std::next(i_op));
+			TermNode::Container left(a), right(a);
+
+			res.push_back(
+				Unilang::AsTermNode(a, trans.MakePrefix(i_op->Value)));
+			codes.push_back(Classify(res.back()) | Layout::CreatedItem);
+			con.erase(i_op);
+			if(p - first < last - p - 1)
+			{
+				left.splice(left.end(), con, con.begin(), i_right);
+				right.swap(con);
+			}
+			else
+			{
+				right.splice(right.end(), con, i_right, con.end());
+				left.swap(con);
+			}
+			add_part(left, first, p);
+			add_part(right, p + 1, last);
+		}
+		}
+		con.swap(res);
+		work.Layouts.push_front(MakeLayout(std::move(codes)));
+		p_layout = &work.Layouts.front();
+		first = 0;
+		last = p_layout->Codes.size();
+	}
+
+	auto k(first);
+
+	for(auto& sub : con)
+	{
+		if(p_layout->IsCreated(k))
+		{
+			if(IsBranch(sub))
+			{
+				const auto i(work.Parts.find(&sub));
+
+				assert(i != work.Parts.end() && "Invalid subterm found.");
+				i->second.SkipBinary = skip_binary;
+				work.Items.push_back(i->second);
+				work.Parts.erase(i);
+			}
 		}
+		else if(IsBranch(sub))
+			terms.push({sub, skip_binary});
+		++k;
 	}
 }
 
 
 GlobalState::GlobalState(TermNode::allocator_type a)
-	: Allocator(a), ConvertLeaf([this](const GParsedValue<ByteParser>& str){
+	: GlobalState(a, {})
+{}
+GlobalState::GlobalState(TermNode::allocator_type a,
+	observer_ptr<ArenaResource> p_arena)
+	: Allocator(a), ScratchArena(p_arena),
+	ScratchAllocator(p_arena ? TermNode::allocator_type(p_arena.get()) : a),
+	ConvertLeaf([this](const GParsedValue<ViewByteParser>& id){
 	TermNode term(Allocator);
-	const auto id(YSLib::make_string_view(str));
 
 	if(!id.empty())
-		ParseLeaf(term, id);
+		ParseLeaf(term, Symbols, id);
 	return term;
-}), ConvertLeafSourced([this](const GParsedValue<SourcedByteParser>& val,
+}), ConvertLeafSourced([this](const GParsedValue<SourcedViewByteParser>& val,
 	const Context& ctx){
 	TermNode term(Allocator);
-	const auto id(YSLib::make_string_view(val.second));
+	const auto& id(val.second);
 
 	if(!id.empty())
-		ParseLeafWithSourceInformation(term, id, ctx.CurrentSource,
-			val.first);
+		ParseLeafWithSourceInformation(term, Symbols, id,
+			MakeSourceTag(ctx, val.first));
 	return term;
 })
 {}
 
+SourceTag
+GlobalState::MakeSourceTag(const Context& ctx, const SourceLocation& src_loc)
+	const
+{
+	if(ctx.CurrentSource != last_source)
+	{
+		last_source_id = RegisterSourceName(ctx.CurrentSource);
+		last_source = ctx.CurrentSource;
+	}
+	return {last_source_id, src_loc};
+}
+
 TermNode
 GlobalState::Read(string_view unit, Context& ctx) const
 {
+	// NOTE: The guard shall be destroyed after the parsers.
+	const ArenaRewindGuard gd(ScratchArena);
 	LexicalAnalyzer lexer;
 
+	// NOTE: The lexemes are slices of the unit except for those transformed by
+	//	unescaping, so the unit shall be alive until the tree is built.
 	if(UseSourceLocation)
 	{
-		SourcedByteParser parse(lexer, ctx.get_allocator());
+		SourcedViewByteParser parse(lexer, unit, ScratchAllocator);
 
-		return Prepare(ctx, unit.begin(), unit.end(), ystdex::ref(parse));
+		parse.Scan();
+		return Prepare(ctx, ystdex::ref(parse));
 	}
-	return Prepare(lexer, ctx, unit.begin(), unit.end());
+
+	ViewByteParser parse(lexer, unit, ScratchAllocator);
+
+	parse.Scan();
+	return Prepare(ctx, ystdex::ref(parse));
 }
 
 TermNode
 GlobalState::ReadFrom(std::streambuf& buf, Context& ctx) const
 {
 	using s_it_t = std::istreambuf_iterator<char>;
+	// NOTE: Ditto.
+	const ArenaRewindGuard gd(ScratchArena);
 	LexicalAnalyzer lexer;
 
 	if(UseSourceLocation)
 	{
-		SourcedByteParser parse(lexer, ctx.get_allocator());
+		SourcedByteParser parse(lexer, ScratchAllocator);
 
 		return Prepare(ctx, s_it_t(&buf), s_it_t(), ystdex::ref(parse));
 	}
@@ -623,5 +1238,21 @@ GlobalState::ReadFrom(std::istream& is, Context& ctx) const
 		throw std::invalid_argument("Invalid stream found.");
 }
 
+
+FormReader::FormReader(std::streambuf& buf, Context& ctx)
+	: buffer_ref(buf), parse(lexer, ctx.Global.get().Allocator),
+	parse_sourced(lexer, ctx.Global.get().Allocator),
+	source_name(ctx.CurrentSource)
+{}
+
+bool
+FormReader::Read(TermNode& term, Context& ctx)
+{
+	ctx.CurrentSource = source_name;
+	return ctx.Global.get().UseSourceLocation ? ReadTopLevelForm(buffer_ref,
+		parse_sourced, depth, separated, term, ctx) : ReadTopLevelForm(
+		buffer_ref, parse, depth, separated, term, ctx);
+}
+
 } // namespace Unilang;
 
@@ -146,40 +146,38 @@ EnsureLValueReference(TermReference&& ref)
 }
 
 ReductionStatus
-EvaluateLeafToken(TermNode& term, Context& ctx, string_view id)
+BindLeafToken(TermNode& term, Context& ctx, TermNode& bound,
+	const shared_ptr<Environment>& p_env)
 {
-	assert(id.data());
-
-	auto pr(ctx.Resolve(ctx.GetRecordPtr(), id));
-
-	if(pr.first)
+	if(!ctx.TrySetTailOperatorName(term))
+		ctx.OperatorName.Clear();
+	if(const auto p_bound = TryAccessLeafAtom<const TermReference>(bound))
 	{
-		auto& bound(*pr.first);
+		term.GetContainerRef() = bound.GetContainer();
+		term.Value = EnsureLValueReference(TermReference(*p_bound));
+	}
+	else
+		// NOTE: The environment reference is initialized from the owner
+		//	directly to avoid the redundant reference counting operations of
+		//	the temporary pointers.
+		term.Value = TermReference(Unilang::Deref(p_env).MakeTermTags(bound)
+			& ~TermTags::Unique, bound, p_env);
+	return ReductionStatus::Neutral;
+}
 
-		if(!ctx.TrySetTailOperatorName(term))
-			ctx.OperatorName.Clear();
-		if(const auto p_bound = TryAccessLeafAtom<const TermReference>(bound))
-		{
-			term.GetContainerRef() = bound.GetContainer();
-			term.Value = EnsureLValueReference(TermReference(*p_bound));
-		}
-		else
-		{
-			auto p_env(Unilang::Nonnull(pr.second));
+ReductionStatus
+EvaluateLeafToken(TermNode& term, Context& ctx, const TokenValue& id)
+{
+	const auto pr(ctx.Resolve(ctx.GetRecordPtr(), id));
 
-			term.Value = TermReference(p_env->MakeTermTags(bound)
-				& ~TermTags::Unique, bound, std::move(p_env));
-		}
-		return ReductionStatus::Neutral;
-	}
+	if(pr.first)
+		return BindLeafToken(term, ctx, *pr.first, pr.second);
 	throw BadIdentifier(id);
 }
 
 
 using SourcedByteAllocator = pmr::polymorphic_allocator<yimpl(byte)>;
 
-using SourceInfoMetadata = lref<const SourceInformation>;
-
 
 template<typename _type, class _tByteAlloc = SourcedByteAllocator>
 class SourcedHolder : public YSLib::AllocatorHolder<_type, _tByteAlloc>
@@ -191,21 +189,15 @@ public:
 private:
 	using base = YSLib::AllocatorHolder<_type, _tByteAlloc>;
 
-	SourceInformation source_information;
+	SourceTag source_tag;
 
 public:
 	using base::value;
 
 	template<typename... _tParams>
 	inline
-	SourcedHolder(const SourceName& name, const SourceLocation& src_loc,
-		_tParams&&... args)
-		: base(yforward(args)...), source_information(name, src_loc)
-	{}
-	template<typename... _tParams>
-	inline
-	SourcedHolder(const SourceInformation& src_info, _tParams&&... args)
-		: base(yforward(args)...), source_information(src_info)
+	SourcedHolder(const SourceTag& tag, _tParams&&... args)
+		: base(yforward(args)...), source_tag(tag)
 	{}
 	SourcedHolder(const SourcedHolder&) = default;
 	SourcedHolder(SourcedHolder&&) = default;
@@ -220,14 +212,14 @@ public:
 	{
 		return YSLib::AllocatedHolderOperations<SourcedHolder,
 			_tByteAlloc>::CreateHolder(c, x, value, YSLib::forward_as_tuple(
-			source_information, ystdex::as_const(value)),
-			YSLib::forward_as_tuple(source_information, std::move(value)));
+			source_tag, ystdex::as_const(value)),
+			YSLib::forward_as_tuple(source_tag, std::move(value)));
 	}
 
 	YB_ATTR_nodiscard YB_PURE any
 	Query(uintmax_t) const noexcept override
 	{
-		return ystdex::ref(source_information);
+		return source_tag;
 	}
 
 	using base::get_allocator;
@@ -273,7 +265,7 @@ ThrowCombiningFailure(TermNode& term, const Context& ctx, const TermNode& fm,
 	const auto p(ctx.TryGetTailOperatorName(term));
 
 	throw ListReductionFailure(ystdex::sfmt(
-		"No matching combiner '%s%s%s' for operand '%s'.", p ? p->c_str() : "",
+		"No matching combiner '%s%s%s' for operand '%s'.", p ? p->data() : "",
 		p ? ": " : "", TermToStringWithReferenceMark(fm, has_ref).c_str(),
 		TermToStringWithReferenceMark(term, {}, 1).c_str()));
 }
@@ -309,6 +301,27 @@ ReduceCombining(TermNode& term, Context& ctx)
 }
 
 
+YB_ATTR_nodiscard YB_PURE bool
+IsDefaultReducer(const Context& ctx) noexcept
+{
+	const auto p(ctx.ReduceOnce.Handler.target<ReductionStatus(*)(TermNode&,
+		Context&)>());
+
+	return p && *p == Context::DefaultReduceOnce;
+}
+
+TNIter
+ReduceLeavesInPlace(TNIter first, TNIter last, Context& ctx)
+{
+	// NOTE: The leaves are reduced in place since they never capture the
+	//	continuations. Only the combinations need the asynchronous calls. This
+	//	is same to the default reducer, but other reducers shall see all terms.
+	if(IsDefaultReducer(ctx))
+		while(first != last && !IsCombiningTerm(*first))
+			yunused(ReduceLeaf(*first++, ctx));
+	return first;
+}
+
 inline ReductionStatus
 ReduceChildrenOrderedAsync(TNIter, TNIter, Context&);
 
@@ -316,6 +329,9 @@ ReductionStatus
 ReduceChildrenOrderedAsyncUnchecked(TNIter first, TNIter last, Context& ctx)
 {
 	assert(first != last && "Invalid range found.");
+	first = ReduceLeavesInPlace(first, last, ctx);
+	if(first == last)
+		return ReductionStatus::Neutral;
 
 	auto& term(*first++);
 
@@ -332,13 +348,25 @@ ReduceChildrenOrderedAsync(TNIter first, TNIter last, Context& ctx)
 		: ReductionStatus::Neutral;
 }
 
+// NOTE: The arguments are reduced before the call to %next. If all arguments
+//	are reduced in place, %next is called directly.
+template<typename _fNext>
 ReductionStatus
-ReduceCallArguments(TermNode& term, Context& ctx)
+ReduceCallArguments(TermNode& term, Context& ctx, _fNext next)
 {
 	assert(!term.empty() && "Invalid term found.");
-	ReduceChildrenOrderedAsyncUnchecked(std::next(term.begin()), term.end(),
-		ctx);
-	return ReductionStatus::Partial;
+
+	const auto i(ReduceLeavesInPlace(std::next(term.begin()), term.end(),
+		ctx));
+
+	if(i != term.end())
+	{
+		RelaySwitched(ctx, NameTypedReducerHandler(std::move(next),
+			"eval-combine-operator"));
+		ReduceChildrenOrderedAsyncUnchecked(i, term.end(), ctx);
+		return ReductionStatus::Partial;
+	}
+	return next(ctx);
 }
 
 
@@ -773,9 +801,9 @@ private:
 			{
 				if(is_list && !ellipsis && !IsList(nd))
 					ThrowListTypeErrorForNonList(nd, p_ref);
-
+
 				const auto n_o(CountPrefix(nd));
-
+
 				if(n_p == n_o || (ellipsis && n_o >= n_p - 1))
 				{
 					auto tags(o_tags);
@@ -810,11 +838,11 @@ private:
 		if(std::get<Ellipsis>(e))
 		{
 			const auto& trailing(Unilang::Deref(mid));
-
+
 			assert(IsAtom(trailing) && "Invalid state found.");
 			assert(IsTyped<TokenValue>(ReferenceTerm(trailing))
 				&& "Invalid ellipsis sequence token found.");
-
+
 			string_view id(
 				ReferenceTerm(trailing).Value.template GetObject<TokenValue>());
 
@@ -827,7 +855,7 @@ private:
 			Bind(o_nd, std::get<OperandFirst>(e), *p, std::get<OperandTags>(e),
 				std::get<EnvironmentRef>(e));
 	}
-
+
 	template<typename... _tParams>
 	static void
 	ThrowIfNonempty(const TermNode& o, _tParams&&...)
@@ -959,6 +987,23 @@ FetchNameTableRef()
 	return ystdex::parameterize_static_object<NameTable, _tKey>();
 }
 
+mutex SourceNameTableMutex;
+
+struct SourceNameTable final
+{
+	// NOTE: The identifiers are the indices of the names.
+	vector<SourceName> Names{SourceName()};
+	unordered_map<string, size_t, SymbolStringHash, ystdex::equal_to<>> IDs{};
+};
+
+YB_ATTR_nodiscard SourceNameTable&
+FetchSourceNameTableRef()
+{
+	static SourceNameTable tbl;
+
+	return tbl;
+}
+
 } // unnamed namespace;
 
 
@@ -990,7 +1035,7 @@ ReduceOrdered(TermNode& term, Context& ctx)
 
 
 void
-ParseLeaf(TermNode& term, string_view id)
+ParseLeaf(TermNode& term, SymbolTable& symbols, string_view id)
 {
 	assert(id.data());
 	assert(!id.empty() && "Invalid leaf token found.");
@@ -998,11 +1043,11 @@ ParseLeaf(TermNode& term, string_view id)
 	{
 	case LexemeCategory::Code:
 		id = DeliteralizeUnchecked(id);
-		term.SetValue(in_place_type<TokenValue>, id, term.get_allocator());
+		term.SetValue(in_place_type<TokenValue>, symbols.Intern(id));
 		break;
 	case LexemeCategory::Symbol:
 		if(ParseSymbol(term, id))
-			term.SetValue(in_place_type<TokenValue>, id, term.get_allocator());
+			term.SetValue(in_place_type<TokenValue>, symbols.Intern(id));
 		break;
 	case LexemeCategory::Data:
 		term.SetValue(in_place_type<string>, Deliteralize(id),
@@ -1014,8 +1059,8 @@ ParseLeaf(TermNode& term, string_view id)
 }
 
 void
-ParseLeafWithSourceInformation(TermNode& term, string_view id,
-	const shared_ptr<string>& name, const SourceLocation& src_loc)
+ParseLeafWithSourceInformation(TermNode& term, SymbolTable& symbols,
+	string_view id, const SourceTag& tag)
 {
 	assert(id.data());
 	assert(!id.empty() && "Invalid leaf token found.");
@@ -1024,22 +1069,71 @@ ParseLeafWithSourceInformation(TermNode& term, string_view id,
 	case LexemeCategory::Code:
 		id = DeliteralizeUnchecked(id);
 		term.SetValue(any_ops::use_holder, in_place_type<SourcedHolder<
-			TokenValue>>, name, src_loc, id, term.get_allocator());
+			TokenValue>>, tag, symbols.Intern(id));
 		break;
 	case LexemeCategory::Symbol:
 		if(ParseSymbol(term, id))
 			term.SetValue(any_ops::use_holder, in_place_type<SourcedHolder<
-				TokenValue>>, name, src_loc, id, term.get_allocator());
+				TokenValue>>, tag, symbols.Intern(id));
 		break;
 	case LexemeCategory::Data:
 		term.SetValue(any_ops::use_holder, in_place_type<SourcedHolder<string>>,
-			name, src_loc, Deliteralize(id), term.get_allocator());
+			tag, Deliteralize(id), term.get_allocator());
 		YB_ATTR_fallthrough;
 	default:
 		break;
 	}
 }
 
+void
+SetSourcedValue(TermNode& term, const TokenValue& tv, const SourceTag& tag)
+{
+	term.SetValue(any_ops::use_holder, in_place_type<SourcedHolder<
+		TokenValue>>, tag, tv);
+}
+void
+SetSourcedValue(TermNode& term, string_view sv, const SourceTag& tag)
+{
+	term.SetValue(any_ops::use_holder, in_place_type<SourcedHolder<string>>,
+		tag, string(sv.data(), sv.size(), term.get_allocator()));
+}
+
+size_t
+RegisterSourceName(const SourceName& name)
+{
+	if(name)
+	{
+		const lock_guard<mutex> gd(SourceNameTableMutex);
+		auto& tbl(FetchSourceNameTableRef());
+		const auto i(tbl.IDs.find(*name));
+
+		if(i != tbl.IDs.cend())
+			return i->second;
+
+		const auto id(tbl.Names.size());
+
+		// NOTE: The saturated identifier is reserved for the names not
+		//	registered.
+		if(id < SourceTag::Mask(SourceTag::IDBits))
+		{
+			tbl.Names.push_back(name);
+			tbl.IDs.emplace(*name, id);
+			return id;
+		}
+		return size_t(SourceTag::Mask(SourceTag::IDBits));
+	}
+	return 0;
+}
+
+SourceName
+QuerySourceName(size_t id)
+{
+	const lock_guard<mutex> gd(SourceNameTableMutex);
+	const auto& names(FetchSourceNameTableRef().Names);
+
+	return id < names.size() ? names[id] : SourceName();
+}
+
 
 ReductionStatus
 FormContextHandler::CallHandler(TermNode& term, Context& ctx) const
@@ -1052,11 +1146,10 @@ FormContextHandler::CallN(size_t n, TermNode& term, Context& ctx) const
 {
 	if(n == 0 || term.size() <= 1)
 		return FormContextHandler::CallHandler(term, ctx);
-	return Unilang::RelayCurrentNext(ctx, term, ReduceCallArguments,
-		NameTypedReducerHandler([&, n](Context& c){
+	return ReduceCallArguments(term, ctx, [&, n](Context& c){
 		c.SetNextTermRef(term);
 		return CallN(n - 1, term, c);
-	}, "eval-combine-operator"));
+	});
 }
 
 void
@@ -1083,12 +1176,12 @@ FormContextHandler::DoCall1(const FormContextHandler& fch, TermNode& term,
 {
 	assert(fch.wrapping == 1 && "Unexpected wrapping count found.");
 	AssertNextTerm(ctx, term);
-	return term.size() <= 1 ? fch.CallHandler(term, ctx)
-		: Unilang::RelayCurrentNext(ctx, term, ReduceCallArguments,
-		NameTypedReducerHandler([&](Context& c){
-		c.SetNextTermRef(term);
-		return fch.CallHandler(term, c);
-	}, "eval-combine-operator"));
+	if(term.size() > 1)
+		return ReduceCallArguments(term, ctx, [&](Context& c){
+			c.SetNextTermRef(term);
+			return fch.CallHandler(term, c);
+		});
+	return fch.CallHandler(term, ctx);
 }
 
 ReductionStatus
@@ -1118,15 +1211,15 @@ FormContextHandler::Equals(const FormContextHandler& fch) const
 ReductionStatus
 ReduceLeaf(TermNode& term, Context& ctx)
 {
-	const auto res(ystdex::call_value_or([&](string_view id){
+	const auto res(ystdex::call_value_or([&](const TokenValue& id){
 		try
 		{
 			return EvaluateLeafToken(term, ctx, id);
 		}
 		catch(BadIdentifier& e)
 		{
-			if(const auto p_si = QuerySourceInformation(term.Value))
-				e.Source = *p_si;
+			if(const auto o_si = QuerySourceInformation(term.Value))
+				e.Source = *o_si;
 			throw;
 		}
 	}, TermToNamePtr(term), ReductionStatus::Retained));
@@ -1244,14 +1337,23 @@ QueryContinuationName(const Reducer& act)
 	return QueryTypeName(act.target_type());
 }
 
-const SourceInformation*
-QuerySourceInformation(const ValueObject& vo)
+ystdex::optional<SourceTag>
+QuerySourceTag(const ValueObject& vo)
 {
 	const auto val(vo.Query());
 
-	return ystdex::call_value_or([](const SourceInfoMetadata& r) noexcept{
-		return &r.get();
-	}, val.try_get_object_ptr<SourceInfoMetadata>());
+	if(const auto p = val.try_get_object_ptr<SourceTag>())
+		return *p;
+	return {};
+}
+
+ystdex::optional<SourceInformation>
+QuerySourceInformation(const ValueObject& vo)
+{
+	if(const auto o_tag = QuerySourceTag(vo))
+		return SourceInformation(QuerySourceName(o_tag->GetID()),
+			o_tag->GetLocation());
+	return {};
 }
 
 string_view
@@ -1295,11 +1397,11 @@ TraceAction(const Reducer& act, YSLib::Logger& trace)
 				{
 					const auto p_o(p_opn_t->data());
 #	if true
-					if(const auto p_si = QuerySourceInformation(op))
+					if(const auto o_si = QuerySourceInformation(op))
 						trace.TraceFormat(Notice, "#[continuation: %s (%s) @ %s"
-							" (line %zu, column %zu)]", p_o, p, p_si->first
-							? p_si->first->c_str() : "<unknown>",
-							p_si->second.Line + 1, p_si->second.Column + 1);
+							" (line %zu, column %zu)]", p_o, p, o_si->first
+							? o_si->first->c_str() : "<unknown>",
+							o_si->second.Line + 1, o_si->second.Column + 1);
 					else
 #	endif
 						trace.TraceFormat(Notice, "#[continuation: %s (%s)]",
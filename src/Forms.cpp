@@ -11,16 +11,17 @@
 //	Unilang::EmplaceCallResultOrReturn, RemoveHead;
 #include "Exception.h" // for InvalidSyntax, ThrowTypeErrorForInvalidType,
 //	TypeError, ArityMismatch, ThrowListTypeErrorForNonList, UnilangException,
-//	ThrowValueCategoryError;
+//	ThrowValueCategoryError, ThrowListTypeErrorForAtom;
 #include <ystdex/optional.h> // for ystdex::optional;
 #include <exception> // for std::throw_with_nested;
 #include "Evaluation.h" // for IsIgnore, RetainN, std::next,
 //	BindParameterWellFormed, Unilang::MakeForm, CheckVariadicArity, Form,
-//	RetainList, ReduceForCombinerRef, Strict, Unilang::NameTypedContextHandler;
+//	RetainList, ReduceForCombinerRef, Strict, Unilang::NameTypedContextHandler,
+//	CheckArgumentList;
 #include "Context.h" // for ResolveEnvironment, ResolveEnvironmentValue,
 //	Unilang::AssignParent, EnvironmentParent;
 #include "TermNode.h" // for TNIter, IsTypedRegular, Unilang::AsTermNode,
-//	CountPrefix, TNCIter;
+//	CountPrefix, TNCIter, IsPair, IsSticky, PropagateTo, GetLValueTagsOf;
 #include <ystdex/algorithm.hpp> // for ystdex::fast_all_of;
 #include <ystdex/range.hpp> // for ystdex::cbegin, ystdex::cend;
 #include "TCO.h" // for RefTCOAction, ReduceSubsequent, Action, OneShotChecker;
@@ -59,11 +60,7 @@ ExtractEnvironmentFormal(const TermNode& term)
 			ResolveTerm([&](const TermNode& nd, ResolvedTermReferencePtr p_ref)
 			-> ystdex::optional<string>{
 			if(const auto p = TermToNamePtr(nd))
-			{
-				if(Unilang::IsMovable(p_ref))
-					return string(std::move(*p));
-				return string(*p, term.get_allocator());
-			}
+				return string(p->data(), p->size(), term.get_allocator());
 			else if(!IsIgnore(nd))
 				ThrowFormalParameterTypeError(nd, p_ref);
 			return {};
@@ -318,21 +315,27 @@ VauBindOne(Context& ctx, const TermNode& formals, TermNode& term)
 	}, term);
 }
 
+// NOTE: The evaluation structure is shared by the copies of the handler. The
+//	reduction modifies the term in place, so the term gets its own copy of
+//	the evaluation structure on each call. The copy is avoided only if the
+//	handler is uniquely owned by the temporary combiner being called, where
+//	the evaluation structure is moved to the term and left empty, since the
+//	handler is then dropped by popping the frame.
 void
 VauPrepareCall(Context& ctx, TermNode& term, EnvironmentParent& parent,
-	TermNode& eval_struct, bool move)
+	shared_ptr<TermNode>& p_eval_struct, bool move)
 {
 	AssertNextTerm(ctx, term);
 	if(move)
 	{
 		Unilang::AssignParent(ctx, std::move(parent));
-		term.SetContent(std::move(eval_struct));
+		term.SetContent(std::move(*p_eval_struct));
 		RefTCOAction(ctx).PopTopFrame();
 	}
 	else
 	{
 		Unilang::AssignParent(ctx, parent);
-		term.SetContent(eval_struct);
+		term.SetContent(ystdex::as_const(*p_eval_struct));
 	}
 }
 
@@ -359,6 +362,14 @@ private:
 	shared_ptr<TermNode> p_formals;
 	GuardCall& guard_call;
 	mutable EnvironmentParent parent;
+	// XXX: The evaluation structure is not kept by
+	//	'shared_ptr<const TermNode>' with the copy-on-write. The first step of
+	//	the reduction of the body already rewrites the term (e.g. a symbol is
+	//	replaced by the reference to its bound object, and a combination is
+	//	reduced in its subterms), so every call would still copy the whole
+	//	structure, only later. Avoiding the copy needs an evaluator not
+	//	modifying the terms of the code, which is not the model of the
+	//	reduction here.
 	mutable shared_ptr<TermNode> p_eval_struct;
 
 public:
@@ -407,10 +418,11 @@ public:
 			auto gd(GuardFreshEnvironment(ctx));
 
 			guard_call(*this, gd, term, ctx);
+			ctx.GetRecordRef().IndexFrame();
 
 			const bool no_lift(NoLifting);
 
-			VauPrepareCall(ctx, term, parent, *p_eval_struct, move);
+			VauPrepareCall(ctx, term, parent, p_eval_struct, move);
 			return RelayForCall(ctx, term, std::move(gd), no_lift);
 		}
 		throw UnilangException("Invalid handler of call found.");
@@ -710,16 +722,137 @@ EqTermValue(TermNode& term, _func f)
 	});
 }
 
+template<typename _func>
+YB_ATTR_nodiscard YB_PURE inline bool
+EqReferenced(const TermNode& x, const TermNode& y, _func f)
+{
+	return IsAtom(x) && IsAtom(y) ? f(x.Value, y.Value)
+		: ystdex::ref_eq<>()(x, y);
+}
+
 template<typename _func>
 void
 EqTermReference(TermNode& term, _func f)
 {
 	EqTermRet(term, [f](const TermNode& x, const TermNode& y){
-		return IsAtom(x) && IsAtom(y) ? f(x.Value, y.Value)
-			: ystdex::ref_eq<>()(x, y);
+		return EqReferenced(x, y, f);
 	}, static_cast<const TermNode&(&)(const TermNode&)>(ReferenceTerm));
 }
 
+YB_ATTR_nodiscard YB_PURE inline bool
+EqvReferenced(const TermNode& x, const TermNode& y)
+{
+	return EqReferenced(x, y, ystdex::equal_to<>());
+}
+
+YB_ATTR_nodiscard YB_PURE bool
+EqualReferenced(const TermNode& x, const TermNode& y)
+{
+	if(!(IsPair(x) && IsPair(y)))
+		return EqvReferenced(x, y);
+
+	struct Frame
+	{
+		const TermNode* XPtr;
+		const TermNode* YPtr;
+		TNCIter I, J;
+	};
+	// NOTE: The nested pairs are compared with an explicit stack to avoid the
+	//	unbounded recursion of the native calls.
+	vector<Frame> frames(x.get_allocator());
+
+	frames.push_back({&x, &y, x.begin(), y.begin()});
+	while(!frames.empty())
+	{
+		auto& fr(frames.back());
+		const bool ex(fr.I == fr.XPtr->end() || IsSticky(fr.I->Tags));
+		const bool ey(fr.J == fr.YPtr->end() || IsSticky(fr.J->Tags));
+
+		if(ex || ey)
+		{
+			// NOTE: The rest of a pair is an atom only if the prefix is
+			//	exhausted. The rest pair is never identical to an atom.
+			if(!(ex && ey && fr.XPtr->Value == fr.YPtr->Value))
+				return {};
+			frames.pop_back();
+		}
+		else
+		{
+			auto& u(ReferenceTerm(*fr.I++));
+			auto& v(ReferenceTerm(*fr.J++));
+
+			if(IsPair(u) && IsPair(v))
+				frames.push_back({&u, &v, u.begin(), v.begin()});
+			else if(!EqvReferenced(u, v))
+				return {};
+		}
+	}
+	return true;
+}
+
+template<typename _func>
+ReductionStatus
+DoAssoc(TermNode& term, _func f)
+{
+	RetainN(term, 2);
+
+	auto i(term.begin());
+	const auto& x(ReferenceTerm(*++i));
+
+	return ResolveTerm([&](TermNode& nd, ResolvedTermReferencePtr p_ref){
+		for(auto j(nd.begin()); j != nd.end() && !IsSticky(j->Tags); ++j)
+		{
+			auto& tm(*j);
+			auto& pr(ReferenceTerm(tm));
+
+			if(IsAtom(pr))
+				ThrowListTypeErrorForAtom(pr, IsReferenceTerm(tm));
+			if(EqReferenced(x, ReferenceTerm(AccessFirstSubterm(pr)), f))
+			{
+				// NOTE: As %first%, the result is a reference to the element
+				//	if the list is a reference. Otherwise, the element is
+				//	moved.
+				if(p_ref)
+				{
+					const auto a(term.get_allocator());
+
+					if(const auto p
+						= TryAccessLeafAtom<const TermReference>(tm))
+						term.SetContent(TermNode::Container(a),
+							ValueObject(std::allocator_arg, a,
+							in_place_type<TermReference>,
+							PropagateTo(p->GetTags(), p_ref->GetTags()), *p));
+					else
+						term.SetContent(TermNode::Container(a),
+							ValueObject(std::allocator_arg, a,
+							in_place_type<TermReference>, GetLValueTagsOf(
+							tm.Tags | p_ref->GetTags()), tm,
+							p_ref->GetEnvironmentReference()));
+					term.Tags = TermTags::Unqualified;
+				}
+				else
+					LiftOther(term, tm);
+				return ReductionStatus::Retained;
+			}
+		}
+		if(IsList(nd))
+		{
+			term.Clear();
+			return ReductionStatus::Retained;
+		}
+		ThrowListTypeErrorForNonList(nd, p_ref);
+	}, *++i);
+}
+
+void
+CheckResolvedList(const TermNode& term)
+{
+	ResolveTerm([](const TermNode& nd, bool has_ref){
+		if(YB_UNLIKELY(!IsList(nd)))
+			ThrowListTypeErrorForNonList(nd, has_ref);
+	}, term);
+}
+
 YB_ATTR_nodiscard YB_PURE inline bool
 TermUnequal(const TermNode& x, const TermNode& y)
 {
@@ -838,7 +971,7 @@ AsForm(TermNode::allocator_type a, _tParams&&... args)
 }
 
 
-YB_ATTR_nodiscard YB_PURE BindingMap&
+YB_ATTR_nodiscard BindingMap&
 FetchDefineMapRef(const shared_ptr<Environment>& p_env)
 {
 	try
@@ -870,6 +1003,47 @@ CheckReference(TermNode& term, void(&f)(TermNode&, bool))
 	}, term);
 }
 
+
+ReductionStatus
+ReduceLoop(TermNode& term, Context& ctx, bool cond)
+{
+	auto i(term.begin());
+	auto& test(*i);
+	auto& body(*++i);
+	auto& work(*++i);
+
+	// NOTE: The reduction replaces the reduced terms by their results in
+	//	place, so the test and the body are kept intact and their copies are
+	//	reduced in the working term in each iteration. Unlike the derived
+	//	forms, no combinations are built to evaluate the copies.
+	work.SetContent(test);
+	return ReduceSubsequent(work, ctx, NameTypedReducerHandler([&, cond]{
+		if(ExtractBool(work) != cond)
+			return ReduceReturnUnspecified(term);
+		work.SetContent(body);
+		RelaySwitched(ctx, NameTypedReducerHandler(std::bind(ReduceLoop,
+			std::ref(term), std::ref(ctx), cond), "eval-loop"));
+		return ReduceOrdered(work, ctx);
+	}, "eval-loop-test"));
+}
+
+ReductionStatus
+LoopImpl(TermNode& term, Context& ctx, bool cond)
+{
+	CheckVariadicArity(term, 0);
+	RemoveHead(term);
+
+	const auto a(term.get_allocator());
+	auto& con(term.GetContainerRef());
+	TermNode body(a);
+
+	body.GetContainerRef().splice(body.GetContainerRef().end(), con,
+		std::next(con.begin()), con.end());
+	con.push_back(std::move(body));
+	con.push_back(TermNode(a));
+	return ReduceLoop(term, ctx, cond);
+}
+
 } // unnamed namespace;
 
 bool
@@ -974,6 +1148,25 @@ EqValue(TermNode& term)
 	EqTermReference(term, ystdex::equal_to<>());
 }
 
+void
+EqualTerm(TermNode& term)
+{
+	EqTermRet(term, EqualReferenced,
+		static_cast<const TermNode&(&)(const TermNode&)>(ReferenceTerm));
+}
+
+ReductionStatus
+Assq(TermNode& term)
+{
+	return DoAssoc(term, YSLib::HoldSame);
+}
+
+ReductionStatus
+Assv(TermNode& term)
+{
+	return DoAssoc(term, ystdex::equal_to<>());
+}
+
 
 ReductionStatus
 If(TermNode& term, Context& ctx)
@@ -1030,6 +1223,38 @@ SetRestRef(TermNode& term)
 	DoSetRest<LiftNoOp>(term);
 }
 
+ReductionStatus
+ListConcat(TermNode& term)
+{
+	auto i(ConsHead(term));
+	auto& x(*i);
+
+	CheckResolvedList(x);
+	LiftToReturn(x);
+	LiftToReturn(*++i);
+	Unilang::TransferSubtermsBefore(*i, x);
+	LiftOtherValue(term, *i);
+	return ReductionStatus::Retained;
+}
+
+ReductionStatus
+Append(TermNode& term)
+{
+	CheckArgumentList(term);
+	RemoveHead(term);
+
+	TermNode::Container con(term.get_allocator());
+
+	for(auto& tm : term)
+	{
+		CheckResolvedList(tm);
+		LiftToReturn(tm);
+		Unilang::TransferSubtermsAfter(con, tm);
+	}
+	term.GetContainerRef().swap(con);
+	return ReductionStatus::Retained;
+}
+
 
 ReductionStatus
 Eval(TermNode& term, Context& ctx)
@@ -1213,6 +1438,18 @@ Sequence(TermNode& term, Context& ctx)
 	return ReduceOrdered(term, ctx);
 }
 
+ReductionStatus
+While(TermNode& term, Context& ctx)
+{
+	return LoopImpl(term, ctx, true);
+}
+
+ReductionStatus
+Until(TermNode& term, Context& ctx)
+{
+	return LoopImpl(term, ctx, {});
+}
+
 
 ReductionStatus
 Call1CC(TermNode& term, Context& ctx)
@@ -2,7 +2,7 @@
 
 #include "Interpreter.h" // for TokenValue, ystdex::sfmt, HasValue,
 //	string_view, std::bind, Unilang::SwitchToFreshEnvironment,
-//	Unilang::ToParent, std::getline;
+//	Unilang::ToParent, std::getline, Unilang::allocate_shared, FormReader;
 #include <ostream> // for std::ostream;
 #include "Math.h" // for FPToString;
 #include <ystdex/functional.hpp> // for ystdex::bind1, std::placeholders::_1;
@@ -11,11 +11,13 @@
 #include YFM_YSLib_Core_YException // for YSLib, YSLib::ExtractException,
 //	YSLib::Notice, YSLib::stringstream;
 #include YFM_YSLib_Service_TextFile // for Text::OpenSkippedBOMtream,
-//	Text::BOM_UTF_8, YSLib::share_move;
+//	Text::BOM_UTF_8, YSLib::share_move, IO::MappedFile, YSLib::make_unique;
 #include <exception> // for std::throw_with_nested, std::rethrow_exception;
 #include <ystdex/scope_guard.hpp> // for ystdex::make_guard;
 #include "Evaluation.h" // for Unilang::NameTypedReducerHandler;
 #include <iostream> // for std::cout, std::endl, std::cin;
+#include "TermImage.h" // for TermImageCache;
+#include <sys/stat.h> // for struct ::stat, ::stat;
 
 namespace Unilang
 {
@@ -61,7 +63,7 @@ StringifyValueObject(const ValueObject& vo)
 	if(const auto p = vo.AccessPtr<string>())
 		return ystdex::quote(*p);
 	if(const auto p = vo.AccessPtr<TokenValue>())
-		return *p;
+		return string(*p);
 	if(const auto p = vo.AccessPtr<bool>())
 		return *p ? "#t" : "#f";
 	if(const auto p = vo.AccessPtr<int>())
@@ -182,6 +184,58 @@ OpenFile(const char* filename)
 	}
 }
 
+YB_ATTR_nodiscard YB_NONNULL(1) bool
+IsNonemptyRegularFile(const char* filename) noexcept
+{
+	struct ::stat buf;
+
+	return ::stat(filename, &buf) == 0 && (buf.st_mode & S_IFMT) == S_IFREG
+		&& buf.st_size > 0;
+}
+
+YSLib::unique_ptr<YSLib::IO::MappedFile>
+TryMapFile(const char* filename) noexcept
+{
+	// NOTE: Only the nonempty regular files are mapped. Other files, e.g. the
+	//	empty files, FIFOs and the files in '/proc', are read by the stream.
+	if(IsNonemptyRegularFile(filename))
+		try
+		{
+			auto p_mapped(YSLib::make_unique<YSLib::IO::MappedFile>(filename));
+
+			if(p_mapped->GetPtr() && p_mapped->GetSize() != 0)
+				return p_mapped;
+		}
+		catch(std::exception&)
+		{}
+	return {};
+}
+
+TermNode
+ReadMappedFile(Context& ctx, string filename)
+{
+	if(const auto p_mapped = TryMapFile(filename.c_str()))
+	{
+		string_view unit(reinterpret_cast<const char*>(p_mapped->GetPtr()),
+			p_mapped->GetSize());
+		const string_view bom("\xEF\xBB\xBF");
+
+		if(unit.substr(0, bom.length()) == bom)
+			unit.remove_prefix(bom.length());
+		// NOTE: The mapping is kept alive during the reading, so the lexemes
+		//	can refer to the mapped source directly without copying.
+		if(const auto p_cache = ctx.Global.get().ImageCache)
+			return p_cache->Read(ctx, std::move(filename), unit);
+		ctx.CurrentSource = YSLib::share_move(filename);
+		return ctx.Global.get().Read(unit, ctx);
+	}
+
+	const auto p_is(OpenFile(filename.c_str()));
+
+	ctx.CurrentSource = YSLib::share_move(filename);
+	return ctx.Global.get().ReadFrom(*p_is, ctx);
+}
+
 template<typename _func>
 inline void
 RewriteBy(Context& ctx, _func f)
@@ -204,7 +258,9 @@ SetupExceptionHandler(Context& ctx, _func f)
 } // unnamed namespace;
 
 
-Interpreter::Interpreter()
+Interpreter::Interpreter(TermNode::allocator_type a,
+	observer_ptr<ArenaResource> p)
+	: Global(a, p)
 {
 	Global.UseSourceLocation = UseSourceLocation;
 }
@@ -223,6 +279,23 @@ Interpreter::ExecuteOnce(Context& ctx)
 	return ReduceOnce(Term, ctx);
 }
 
+ReductionStatus
+Interpreter::ExecuteStream(Context& ctx, const shared_ptr<std::istream>& p_is,
+	const shared_ptr<FormReader>& p_reader)
+{
+	if(Unilang::Deref(p_reader).Read(Term, ctx))
+	{
+		// NOTE: The following forms are read only after the current form is
+		//	evaluated. The continuation is dropped on the exception, so the
+		//	remained forms are not evaluated, as the whole script.
+		RelaySwitched(ctx, std::bind(&Interpreter::ExecuteStream,
+			std::ref(*this), std::placeholders::_1, p_is, p_reader));
+		PrepareEcho(ctx);
+		return ExecuteOnce(ctx);
+	}
+	return ReductionStatus::Neutral;
+}
+
 ReductionStatus
 Interpreter::ExecuteString(string_view unit, Context& ctx)
 {
@@ -275,10 +348,13 @@ Interpreter::OpenUnique(Context& ctx, string filename)
 void
 Interpreter::PrepareExecution(Context& ctx)
 {
-	SetupExceptionHandler(ctx, [&](std::exception_ptr p,
-		const Context::ReducerSequence::const_iterator& i){
-		HandleWithTrace(std::move(p), ctx, i);
-	});
+	PrepareTrace(ctx);
+	PrepareEcho(ctx);
+}
+
+void
+Interpreter::PrepareEcho(Context& ctx)
+{
 	if(Echo)
 		RelaySwitched(ctx, Unilang::NameTypedReducerHandler([&]{
 			Print(Term);
@@ -286,6 +362,15 @@ Interpreter::PrepareExecution(Context& ctx)
 		}, "repl-print"));
 }
 
+void
+Interpreter::PrepareTrace(Context& ctx)
+{
+	SetupExceptionHandler(ctx, [&](std::exception_ptr p,
+		const Context::ReducerSequence::const_iterator& i){
+		HandleWithTrace(std::move(p), ctx, i);
+	});
+}
+
 void
 Interpreter::Print(const TermNode& term)
 {
@@ -308,6 +393,12 @@ Interpreter::Read(string_view unit)
 	return Global.Read(unit, Main);
 }
 
+TermNode
+Interpreter::ReadFile(Context& ctx, string filename)
+{
+	return ReadMappedFile(ctx, std::move(filename));
+}
+
 void
 Interpreter::Run()
 {
@@ -330,12 +421,32 @@ Interpreter::RunLine(string_view unit)
 void
 Interpreter::RunScript(string filename)
 {
+	// NOTE: For the standard input and the files other than the regular
+	//	files (e.g. pipes), the top-level forms are evaluated once they are
+	//	read, so the evaluation starts before the end of the input and the
+	//	whole script is never kept. The regular files are read as a whole by
+	//	the mapped file, which can be cached by %Interpreter::ReadFile.
 	if(filename == "-")
 	{
 		Main.ShareCurrentSource("*STDIN*");
+		RewriteBy(Main, [&](Context& ctx){
+			PrepareTrace(ctx);
+			if(!(std::cin && std::cin.rdbuf()))
+				throw std::invalid_argument("Invalid stream found.");
+
+			// XXX: The standard input is not owned.
+			const shared_ptr<std::istream> p_is(shared_ptr<void>(), &std::cin);
+
+			return ExecuteStream(ctx, p_is, Unilang::allocate_shared<
+				FormReader>(Global.Allocator, *p_is->rdbuf(), ctx));
+		});
+	}
+	else if(IsNonemptyRegularFile(filename.c_str()))
+	{
+		Main.ShareCurrentSource(filename);
 		RewriteBy(Main, [&](Context& ctx){
 			PrepareExecution(ctx);
-			Term = Global.ReadFrom(std::cin, Main);
+			Term = ReadFile(Main, std::move(filename));
 			return ExecuteOnce(ctx);
 		});
 	}
@@ -343,10 +454,13 @@ Interpreter::RunScript(string filename)
 	{
 		Main.ShareCurrentSource(filename);
 		RewriteBy(Main, [&](Context& ctx){
-			PrepareExecution(ctx);
-			Term
-				= Global.ReadFrom(*OpenUnique(Main, std::move(filename)), Main);
-			return ExecuteOnce(ctx);
+			PrepareTrace(ctx);
+
+			const shared_ptr<std::istream>
+				p_is(OpenUnique(Main, std::move(filename)));
+
+			return ExecuteStream(ctx, p_is, Unilang::allocate_shared<
+				FormReader>(Global.Allocator, *p_is->rdbuf(), ctx));
 		});
 	}
 }
@@ -63,19 +63,16 @@ Driver::Run()
 {
 }
 
-
-ReductionStatus
-JITReduceOnce(TermNode& term, Context& ctx)
-{
-	return Context::DefaultReduceOnce(term, ctx);
-}
-
 } // unnamed namespace;
 
 void
 SetupJIT(Context& ctx)
 {
-	ctx.ReduceOnce = Continuation(JITReduceOnce, ctx);
+	// NOTE: Nothing is compiled yet, so the default reducer is kept. This also
+	//	keeps the reduction of the leaf arguments in place. A compiled tier of
+	//	the closures would have to implement the TCO, the environments and the
+	//	references of the reducer again.
+	ctx.ReduceOnce = Continuation(Context::DefaultReduceOnce, ctx);
 }
 
 void
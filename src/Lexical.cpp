@@ -1,6 +1,7 @@
 ﻿// SPDX-FileCopyrightText: 2020-2021 UnionTech Software Technology Co.,Ltd.
 
-#include "Lexical.h" // for string, assert, std::string;
+#include "Lexical.h" // for string, assert, std::string, IsPlainCharacter,
+//	ystdex::isspace;
 #include <ystdex/string.hpp> // for ystdex::get_mid, ystdex::quote;
 #include "Exception.h" // for UnilangException;
 
@@ -214,6 +215,35 @@ EscapeLiteral(string_view sv)
 }
 
 
+size_t
+ScanPlainLength(string_view sv) noexcept
+{
+	assert(sv.data());
+
+	size_t i(0);
+
+	// NOTE: Plain runs are usually short, so no block scanning is used. See
+	//	test/lexing.txt for the benchmark.
+	while(i < sv.length() && IsPlainCharacter(sv[i]))
+		++i;
+	return i;
+}
+
+size_t
+ScanSpaceLength(string_view sv) noexcept
+{
+	assert(sv.data());
+
+	size_t i(0);
+
+	// NOTE: Runs of whitespaces are usually short, so no block scanning is
+	//	used.
+	while(i < sv.length() && ystdex::isspace(sv[i]))
+		++i;
+	return i;
+}
+
+
 LexemeCategory
 CategorizeBasicLexeme(string_view id) noexcept
 {
@@ -30,7 +30,8 @@
 #include <ystdex/functional.hpp> // for ystdex::bind1;
 #include YFM_YSLib_Core_YShellDefinition // for std::to_string,
 //	YSLib::make_string_view, YSLib::to_std::string;
-#include <iostream> // for std::ios_base, std::cout, std::endl, std::cin;
+#include <iostream> // for std::ios_base, std::cout, std::endl, std::cin,
+//	std::cerr;
 #include YFM_YSLib_Adaptor_YAdaptor // for YSLib::ufexists, IO::UniqueFile,
 //	uopen, IO::use_openmode_t, YSLib::IO, YSLib::FetchEnvironmentVariable,
 //	YSLib::uremove;
@@ -59,6 +60,9 @@
 //	YSLib::FilterExceptions, YSLib::CommandArguments, YSLib::Alert;
 #include YFM_YSLib_Core_YCoreUtilities // for YSLib::LockCommandArguments;
 #include "UnilangQt.h"
+#include "TermImage.h" // for TermImageCache;
+#include <chrono> // for std::chrono::steady_clock, std::chrono::duration;
+#include "Memory.h" // for PoolResource, ArenaResource, AllocationStatistics;
 
 namespace Unilang
 {
@@ -197,20 +201,18 @@ DoResolve(TermNode(&f)(const Context&, string_view), TermNode& term,
 }
 
 TokenValue
-StringToSymbol(const string& s)
+StringToSymbol(const string& s, Context& ctx)
 {
-	return TokenValue(s);
-}
-TokenValue
-StringToSymbol(string&& s)
-{
-	return TokenValue(std::move(s));
+	return ctx.Global.get().Symbols.Intern(s);
 }
 
-const string&
-SymbolToString(const TokenValue& s) noexcept
+// NOTE: The symbol only refers to the interned name, so the string is always
+//	created. It is allocated by the allocator of the context, as the other
+//	objects created by the reduction.
+string
+SymbolToString(const TokenValue& s, Context& ctx)
 {
-	return s;
+	return string(s.data(), s.size(), ctx.get_allocator());
 }
 
 
@@ -388,14 +390,7 @@ LoadModule_std_strings(Interpreter& intp)
 		to_lwr(y);
 		return x.find(y) != string::npos;
 	});
-	RegisterUnary(m, "string->symbol", [](TermNode& term){
-		return ResolveTerm([&](TermNode& nd, ResolvedTermReferencePtr p_ref){
-			auto& s(AccessRegular<string>(nd, p_ref));
-
-			return Unilang::IsMovable(p_ref) ? StringToSymbol(std::move(s))
-				: StringToSymbol(s);
-		}, term);
-	});
+	RegisterUnary<Strict, const string>(m, "string->symbol", StringToSymbol);
 	RegisterUnary<Strict, const TokenValue>(m, "symbol->string",
 		SymbolToString);
 	RegisterUnary<Strict, const string>(m, "string->regex",
@@ -586,9 +581,8 @@ $defl! puts (&s) $sequence (put s) (() newline);
 		RetainN(term);
 		RefTCOAction(ctx).SaveTailSourceName(ctx.CurrentSource,
 			std::move(ctx.CurrentSource));
-		term = intp.Global.ReadFrom(*intp.OpenUnique(ctx, string(
-			Unilang::ResolveRegular<const string>(Unilang::Deref(
-			std::next(term.begin()))), term.get_allocator())), ctx);
+		term = intp.ReadFile(ctx, string(Unilang::ResolveRegular<const string>(
+			Unilang::Deref(std::next(term.begin()))), term.get_allocator()));
 		intp.Global.Preprocess(term);
 		return ctx.ReduceOnce.Handler(term, ctx);
 	});
@@ -759,8 +753,7 @@ PreloadExternal(Interpreter& intp, const char* filename)
 
 	try
 	{
-		auto term(global.ReadFrom(*intp.OpenUnique(ctx,
-			string(filename, global.Allocator)), ctx));
+		auto term(intp.ReadFile(ctx, string(filename, global.Allocator)));
 
 		intp.Evaluate(term);
 	}
@@ -776,12 +769,20 @@ struct NoCopy final : ystdex::noncopyable
 
 #define Unilang_Default_Init_File "init.txt"
 const char* init_file = Unilang_Default_Init_File;
+// NOTE: The default of the option '--memory-pool' is configurable at build
+//	time for benchmarks.
+#ifndef Unilang_UseMemoryPool
+#	define Unilang_UseMemoryPool false
+#endif
+bool use_memory_pool = Unilang_UseMemoryPool;
 
 void
 LoadFunctions(Interpreter& intp, bool jit, int& argc, char* argv[])
 {
 	using namespace Forms;
 	using namespace std::placeholders;
+	using std::chrono::steady_clock;
+	const auto start(steady_clock::now());
 	auto& ctx(intp.Main);
 	auto& renv(ctx.GetRecordRef());
 	auto& m(renv.GetMapRef());
@@ -792,6 +793,9 @@ LoadFunctions(Interpreter& intp, bool jit, int& argc, char* argv[])
 	RegisterStrict(m, "eq?", Eq);
 	RegisterStrict(m, "eql?", EqLeaf);
 	RegisterStrict(m, "eqv?", EqValue);
+	RegisterStrict(m, "equal?", EqualTerm);
+	RegisterStrict(m, "assq", Assq);
+	RegisterStrict(m, "assv", Assv);
 	RegisterForm(m, "$if", If);
 	RegisterUnary(m, "null?", ComposeReferencedTermOp(IsEmpty));
 	RegisterUnary(m, "branch?", ComposeReferencedTermOp(IsBranch));
@@ -823,9 +827,12 @@ LoadFunctions(Interpreter& intp, bool jit, int& argc, char* argv[])
 	RegisterStrict(m, "cons%", ConsRef);
 	RegisterStrict(m, "set-rest!", SetRest);
 	RegisterStrict(m, "set-rest%!", SetRestRef);
-	RegisterUnary<Strict, const TokenValue>(m, "desigil", [](TokenValue s){
-		return TokenValue(!s.empty() && (s.front() == '&' || s.front() == '%')
-			? s.substr(1) : std::move(s));
+	RegisterStrict(m, "list-concat", ListConcat);
+	RegisterStrict(m, "append", Append);
+	RegisterUnary<Strict, const TokenValue>(m, "desigil",
+		[](const TokenValue& s, Context& ctx){
+		return !s.empty() && (s.front() == '&' || s.front() == '%')
+			? ctx.Global.get().Symbols.Intern(s.substr(1)) : s;
 	});
 	RegisterStrict(m, "eval", Eval);
 	RegisterStrict(m, "eval@", EvalAt);
@@ -914,6 +921,8 @@ $def! $lambda/e% $vau (&p &formals .&body) d
 		(cons p (cons% (forward! formals) (cons% #ignore (forward! body))))) d);
 	)Unilang");
 	RegisterForm(m, "$sequence", Sequence);
+	RegisterForm(m, "$while", While);
+	RegisterForm(m, "$until", Until);
 	intp.Main.ShareCurrentSource("<root:basic-derived-3>");
 	intp.Perform(R"Unilang(
 $def! collapse $lambda% (%x)
@@ -1002,10 +1011,6 @@ $defl%! rest& (&pr)
 $defl! restv ((#ignore .xs)) $move-resolved! xs;
 $defl! set-first! (&pr x) assign@! (first@ (forward! pr)) (move! x);
 $defl! set-first%! (&pr &x) assign%! (first@ (forward! pr)) (forward! x);
-$defl! equal? (&x &y)
-	$if ($if (pair? x) (pair? y) #f)
-		($if (equal? (first& x) (first& y)) (equal? (rest& x) (rest& y)) #f)
-		(eqv? x y);
 $defl%! check-environment (&e) $sequence (eval@ #inert e) (forward! e);
 $defv%! $cond &clauses d
 	$if (null? clauses) #inert
@@ -1016,14 +1021,6 @@ $defv%! $when (&test .&exprseq) d
 	$if (eval test d) (eval% (list* () $sequence (forward! exprseq)) d);
 $defv%! $unless (&test .&exprseq) d
 	$if (eval test d) #inert (eval% (list* () $sequence (forward! exprseq)) d);
-$defv%! $while (&test .&exprseq) d
-	$when (eval test d)
-		(eval% (list* () $sequence exprseq) d)
-		(eval% (list* () $while (forward! test) (forward! exprseq)) d);
-$defv%! $until (&test .&exprseq) d
-	$unless (eval test d)
-		(eval% (list* () $sequence exprseq) d)
-		(eval% (list* () $until (forward! test) (forward! exprseq)) d);
 $defl! not? (x) eqv? x #f;
 $defv%! $and &x d
 	$cond
@@ -1063,8 +1060,6 @@ $defw%! foldr1 (&kons &knil &l) d
 $defw%! map1 (&appv &l) d
 	foldr1 ($lambda (%x &xs) cons%
 		(apply appv (list% ($move-resolved! x)) d) (move! xs)) () (forward! l);
-$defl! list-concat (&x &y) foldr1 cons% (forward! y) (forward! x);
-$defl! append (.&ls) foldr1 list-concat () (move! ls);
 $defl! filter (&accept? &ls) apply append
 	(map1 ($lambda (&x) $if (apply accept? (list x)) (list x) ()) ls);
 $defl%! list-extract-first (&l) map1 first (forward! l);
@@ -1154,12 +1149,6 @@ $defv! $import&! (&e .&symbols) d
 		((unwrap list%) .)) (symbols->imports symbols)) (eval e d);
 $defl! nonfoldable? (&l)
 	$if (null? l) #f ($if (null? (first l)) #t (nonfoldable? (rest& l)));
-$defl%! assq (&x &alist) $cond ((null? alist))
-	((eq? x (first& (first& alist))) first% alist)
-	(#t assq (forward! x) (rest% alist));
-$defl%! assv (&x &alist) $cond ((null? alist))
-	((eqv? x (first& (first& alist))) first% alist)
-	(#t assv (forward! x) (rest% alist));
 $defw%! map-reverse (&appv .&ls) d
 	accl (forward! (check-list-reference ls)) nonfoldable? () list-extract-first
 		list-extract-rest%
@@ -1210,8 +1199,12 @@ $defw! for-each-ltr &ls d $sequence (apply map-reverse (forward! ls) d) #inert;
 	// NOTE: Qt support.
 	InitializeQt(intp, argc, argv);
 	// NOTE: Prevent the ground environment from modification.
-	renv.Freeze();
+	renv.FreezeIndexed();
 	intp.SaveGround();
+	if(std::getenv("UNILANG_STARTUP_TIME"))
+		std::cerr << ystdex::sfmt("Initialized the ground environment in %.3f"
+			" ms.", std::chrono::duration<double, std::milli>(
+			steady_clock::now() - start).count()) << std::endl;
 	// NOTE: User environment initialization.
 	if(init_file)
 		PreloadExternal(intp, init_file);
@@ -1247,7 +1240,14 @@ const struct Option
 	{"-q, --no-init-file", "", {"Disable loading the init file. Otherwise, a"
 		" file named \"" Unilang_Default_Init_File "\" is loaded at the end"
 		" of the initialization and before further evaluations. Currently this"
-		" is effective for both execution modes."}}
+		" is effective for both execution modes."}},
+	{"--memory-pool", "", {"Allocate the objects of the interpreter from a"
+		" pooled memory resource, and allocate the temporary objects in"
+		" reading and preprocessing the code from an arena which is rewound"
+		" after each reading and preprocessing. This is the default if the"
+		" interpreter is built with the macro 'Unilang_UseMemoryPool' defined"
+		" to 'true'."}},
+	{"--no-memory-pool", "", {"Disable the option '--memory-pool'."}}
 };
 
 const std::array<const char*, 3> DeEnvs[]{
@@ -1257,7 +1257,16 @@ const std::array<const char*, 3> DeEnvs[]{
 	{{"UNILANG_NO_SRCINFO", "", "If set, disable the source information from"
 		" the source code for diagnostics. The source names are used"
 		" regardless of this variable."}},
-	{{"UNILANG_PATH", "", "Unilang loader path template string."}}
+	{{"UNILANG_PATH", "", "Unilang loader path template string."}},
+	{{"UNILANG_STARTUP_TIME", "", "If set, report the time of the"
+		" initialization of the ground environment to the standard error."}},
+	{{"UNILANG_CACHE", "", "If set, the path of an existing directory to cache"
+		" the code read from the source files loaded by 'load' and 'require'"
+		" and the regular script files."
+		" The cached code is used only when the source file is not changed."}},
+	{{"UNILANG_MEMORY_STATS", "", "If set, report the statistics of the"
+		" allocations to the standard error when the interpreter exits"
+		" normally. This is effective only with the option '--memory-pool'."}}
 };
 
 
@@ -1297,7 +1306,12 @@ PrintHelpMessage(const string& prog)
 		"\tThe source specified by SRCPATH shall have Unilang source tokens"
 		" encoded in a text stream with optional UTF-8 BOM (byte-order mark),"
 		" which are to be read and evaluated in the initial environment of the"
-		" interpreter. Otherwise, errors are raised to reject the source.\n\n"
+		" interpreter. Otherwise, errors are raised to reject the source.\n"
+		"\tA regular file is read as a whole before the evaluation. The"
+		" standard input and the other files (e.g. pipes) are read by the"
+		" top-level forms separated by ';', and each form is evaluated once it"
+		" is read. So the forms before an error in the remained input,"
+		" including the syntax error, are still evaluated.\n\n"
 		"OPTIONS ...\nOPTIONS ... -- [[SRCPATH] ARGS ...]\n"
 		"\tThe options and arguments for the program execution. After '--',"
 		" options parsing is turned off and every remained command line"
@@ -1345,14 +1359,41 @@ constexpr auto title(APP_NAME " " APP_VER " @ (" __DATE__ ", " __TIME__ ") "
 #endif
 	"] + YSLib");
 
+void
+PrintAllocationStatistics(const char* name, const AllocationStatistics& stat)
+{
+	std::cerr << ystdex::sfmt("%s: %zu allocations, %zu deallocations, %zu"
+		" bytes requested, %zu upstream allocations, %zu bytes at peak from"
+		" the upstream.", name, stat.Allocations, stat.Deallocations,
+		stat.RequestedBytes, stat.UpstreamAllocations, stat.PeakUpstreamBytes)
+		<< std::endl;
+}
+
 template<typename _fCallable, typename... _tParams>
 inline void
 Launch(default_allocator<yimpl(byte)> a, _fCallable&& f, _tParams&&... args)
 {
-	Interpreter intp{};
-
+	const auto cache_dir(std::getenv("UNILANG_CACHE"));
+	// NOTE: The cache shall outlive the interpreter.
+	const TermImageCache cache(cache_dir ? cache_dir : "", a);
+	// NOTE: The memory resources shall outlive the interpreter.
+	PoolResource pool(Unilang::Deref(a.resource()));
+	ArenaResource arena(Unilang::Deref(a.resource()));
+	Interpreter intp(use_memory_pool ? TermNode::allocator_type(&pool)
+		: TermNode::allocator_type(),
+		use_memory_pool ? make_observer(&arena) : nullptr);
+
+	if(cache_dir)
+		intp.Global.ImageCache = make_observer(&cache);
 	Unilang::GuardExceptionsForAllocator(a, yforward(f), intp,
 		yforward(args)...);
+	if(use_memory_pool && std::getenv("UNILANG_MEMORY_STATS"))
+	{
+		PrintAllocationStatistics("Memory pool", pool.Statistics);
+		PrintAllocationStatistics("Arena", arena.Statistics);
+		std::cerr << ystdex::sfmt("Arena: %zu rewinds.", arena.Rewinds)
+			<< std::endl;
+	}
 }
 
 // XXX: Reference to 'argc' is required for Qt initialization.
@@ -1431,6 +1472,12 @@ main(int argc, char* argv[])
 						init_file = {};
 						continue;
 					}
+					else if(arg == "--memory-pool"
+						|| arg == "--no-memory-pool")
+					{
+						use_memory_pool = arg == "--memory-pool";
+						continue;
+					}
 				}
 				if(requires_eval)
 				{
@@ -1,7 +1,7 @@
 ﻿// SPDX-FileCopyrightText: 2021-2023 UnionTech Software Technology Co.,Ltd.
 
 #include "Math.h" // for size_t, type_info, TryAccessValue, Unilang::Nonnull,
-//	lref, ptrdiff_t, string_view, sfmt;
+//	lref, ptrdiff_t, string_view, sfmt, type_id;
 #include <ystdex/exception.h> // for ystdex::unsupported;
 #include <ystdex/string.hpp> // for ystdex::sfmt;
 #include <ystdex/meta.hpp> // for ystdex::_t, ystdex::exclude_self_t,
@@ -15,6 +15,7 @@
 #include <ystdex/functional.hpp> // for ystdex::retry_on_cond, ystdex::id;
 #include <ystdex/cctype.h> // for ystdex::isdigit;
 #include "BasicReduction.h" // for ReductionStatus;
+#include <ystdex/utility.hpp> // for ystdex::as_const;
 
 namespace Unilang
 {
@@ -68,6 +69,26 @@ enum NumCode : size_t
 YB_ATTR_nodiscard YB_PURE NumCode
 MapTypeIdToNumCode(const type_info& ti) noexcept
 {
+	// NOTE: The type information objects are compared by the addresses first,
+	//	since they are unique in most implementations. This avoids the
+	//	comparisons of the names in the chain below, which are costly for the
+	//	mismatched types.
+	static const type_info* const types[]{&type_id<signed char>(),
+		&type_id<unsigned char>(), &type_id<short>(),
+		&type_id<unsigned short>(), &type_id<int>(), &type_id<unsigned>(),
+		&type_id<long>(), &type_id<unsigned long>(), &type_id<long long>(),
+		&type_id<unsigned long long>(), &type_id<float>(),
+		&type_id<double>(), &type_id<long double>()};
+
+	static_assert(sizeof(types) / sizeof(*types) == Max + 1,
+		"Invalid number of types found.");
+	if(&ti == types[Int])
+		return Int;
+	if(&ti == types[Double])
+		return Double;
+	for(size_t i(0); i != Max + 1; ++i)
+		if(&ti == types[i])
+			return NumCode(i);
 	if(IsTyped<int>(ti))
 		return Int;
 	if(IsTyped<unsigned>(ti))
@@ -1052,6 +1073,11 @@ NumBinaryComp(const ValueObject& x, const ValueObject& y) noexcept
 {
 	const auto xcode(MapTypeIdToNumCode(x));
 	const auto ycode(MapTypeIdToNumCode(y));
+
+	// NOTE: The operands of the same type are compared without copying.
+	if(xcode == ycode && xcode != None)
+		return DoNumLeafHinted<bool>(xcode, GBOp<_fBinary, bool>(), x, y);
+
 	const auto ret_bin([](ValueObject u, ValueObject v, NumCode code){
 		return DoNumLeafHinted<bool>(code, GBOp<_fBinary, bool>(), u, v);
 	});
@@ -1066,6 +1092,12 @@ NumBinaryOp(ResolvedArg<>& x, ResolvedArg<>& y)
 {
 	const auto xcode(MapTypeIdToNumCode(x));
 	const auto ycode(MapTypeIdToNumCode(y));
+
+	// NOTE: The operands of the same type are neither moved nor promoted.
+	if(xcode == ycode && xcode != None)
+		return DoNumLeafHinted<_tRet>(xcode, GBOp<_fBinary, _tRet>(),
+			ystdex::as_const(x.get().Value), ystdex::as_const(y.get().Value));
+
 	const auto ret_bin([](ValueObject u, ValueObject v, NumCode code){
 		return DoNumLeafHinted<_tRet>(code, GBOp<_fBinary, _tRet>(), u, v);
 	});
@@ -0,0 +1,263 @@
+﻿// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co.,Ltd.
+
+#include "Memory.h" // for size_t, pmr, byte, lref;
+#include <cstdint> // for std::uintptr_t;
+#include <new> // for placement ::operator new from standard library;
+#include <algorithm> // for std::max;
+#include <cassert> // for assert;
+
+namespace Unilang
+{
+
+namespace
+{
+
+YB_ATTR_nodiscard YB_STATELESS constexpr size_t
+RoundUp(size_t n, size_t align) noexcept
+{
+	return (n + align - 1) / align * align;
+}
+
+YB_ATTR_nodiscard YB_STATELESS byte*
+AlignUp(byte* p, size_t align) noexcept
+{
+	return reinterpret_cast<byte*>((reinterpret_cast<std::uintptr_t>(p)
+		+ align - 1) & ~std::uintptr_t(align - 1));
+}
+
+// NOTE: The chunks are prefixed by the headers. The data of the chunks are
+//	aligned as the blocks in the pools.
+constexpr size_t ChunkAlignment(PoolResource::Granularity);
+
+template<class _tChunk>
+YB_ATTR_nodiscard YB_STATELESS constexpr size_t
+GetChunkDataOffset() noexcept
+{
+	return RoundUp(sizeof(_tChunk), ChunkAlignment);
+}
+
+template<class _tChunk>
+YB_ATTR_nodiscard byte*
+AllocateChunk(pmr::memory_resource& upstream, _tChunk*& p_chunks, size_t n,
+	AllocationStatistics& stat)
+{
+	const auto offset(GetChunkDataOffset<_tChunk>());
+	const auto size(offset + n);
+	const auto p(::new(upstream.allocate(size, ChunkAlignment))
+		_tChunk{p_chunks, size});
+
+	p_chunks = p;
+	stat.AddUpstream(size);
+	return reinterpret_cast<byte*>(p) + offset;
+}
+
+template<class _tChunk>
+void
+ReleaseChunks(pmr::memory_resource& upstream, _tChunk* p,
+	AllocationStatistics& stat) noexcept
+{
+	while(p)
+	{
+		const auto p_next(p->Next);
+		const auto size(p->Size);
+
+		upstream.deallocate(p, size, ChunkAlignment);
+		stat.RemoveUpstream(size);
+		p = p_next;
+	}
+}
+
+YB_ATTR_nodiscard YB_STATELESS constexpr size_t
+GetClassIndex(size_t bytes) noexcept
+{
+	return bytes == 0 ? 0 : (bytes - 1) / PoolResource::Granularity;
+}
+
+YB_ATTR_nodiscard YB_STATELESS constexpr bool
+IsPooled(size_t bytes, size_t alignment) noexcept
+{
+	return bytes <= PoolResource::MaxBlockSize
+		&& alignment <= PoolResource::Granularity;
+}
+
+} // unnamed namespace;
+
+
+void
+AllocationStatistics::AddUpstream(size_t n) noexcept
+{
+	++UpstreamAllocations;
+	UpstreamBytes += n;
+	PeakUpstreamBytes = std::max(PeakUpstreamBytes, UpstreamBytes);
+}
+
+void
+AllocationStatistics::RemoveUpstream(size_t n) noexcept
+{
+	UpstreamBytes -= n;
+}
+
+
+struct PoolResource::Chunk final
+{
+	Chunk* Next;
+	size_t Size;
+};
+
+PoolResource::PoolResource(pmr::memory_resource& rsrc) noexcept
+	: upstream(rsrc)
+{}
+PoolResource::~PoolResource()
+{
+	ReleaseChunks(upstream, p_chunks, Statistics);
+}
+
+void*
+PoolResource::do_allocate(size_t bytes, size_t alignment)
+{
+	++Statistics.Allocations;
+	Statistics.RequestedBytes += bytes;
+	if(IsPooled(bytes, alignment))
+	{
+		const auto i(GetClassIndex(bytes));
+		auto& pool(pools[i]);
+
+		if(const auto p = pool.FreeList)
+		{
+			pool.FreeList = *static_cast<void**>(p);
+			return p;
+		}
+
+		const size_t block_size((i + 1) * Granularity);
+
+		if(pool.Current == pool.End)
+		{
+			const auto n(pool.NextCount * block_size);
+
+			pool.Current = AllocateChunk(upstream, p_chunks, n, Statistics);
+			pool.End = pool.Current + n;
+			// NOTE: The chunks grow until they are about 64KiB.
+			if(n < 65536)
+				pool.NextCount *= 2;
+		}
+
+		const auto p(pool.Current);
+
+		pool.Current += block_size;
+		return p;
+	}
+
+	const auto p(upstream.get().allocate(bytes, alignment));
+
+	Statistics.AddUpstream(bytes);
+	return p;
+}
+
+void
+PoolResource::do_deallocate(void* p, size_t bytes, size_t alignment) noexcept
+{
+	++Statistics.Deallocations;
+	if(IsPooled(bytes, alignment))
+	{
+		auto& pool(pools[GetClassIndex(bytes)]);
+
+		*static_cast<void**>(p) = pool.FreeList;
+		pool.FreeList = p;
+	}
+	else
+	{
+		upstream.get().deallocate(p, bytes, alignment);
+		Statistics.RemoveUpstream(bytes);
+	}
+}
+
+bool
+PoolResource::do_is_equal(const memory_resource& other) const noexcept
+{
+	return this == &other;
+}
+
+
+struct ArenaResource::Chunk final
+{
+	Chunk* Next;
+	size_t Size;
+};
+
+ArenaResource::ArenaResource(pmr::memory_resource& rsrc) noexcept
+	: upstream(rsrc)
+{}
+ArenaResource::~ArenaResource()
+{
+	ReleaseChunks(upstream, p_chunks, Statistics);
+}
+
+void
+ArenaResource::Rewind(const Mark& mark) noexcept
+{
+	++Rewinds;
+	if(mark.ChunkPtr)
+	{
+		// NOTE: The chunks allocated after the mark are before the chunk of
+		//	the mark in the list.
+		while(p_chunks != mark.ChunkPtr)
+		{
+			assert(p_chunks && "Invalid mark found.");
+
+			const auto p_next(p_chunks->Next);
+
+			p_chunks->Next = {};
+			ReleaseChunks(upstream, p_chunks, Statistics);
+			p_chunks = p_next;
+		}
+		current = mark.Current;
+		end = mark.End;
+	}
+	else if(p_chunks)
+	{
+		ReleaseChunks(upstream, p_chunks->Next, Statistics);
+		p_chunks->Next = {};
+		current = reinterpret_cast<byte*>(p_chunks)
+			+ GetChunkDataOffset<Chunk>();
+		end = reinterpret_cast<byte*>(p_chunks) + p_chunks->Size;
+	}
+}
+
+void*
+ArenaResource::do_allocate(size_t bytes, size_t alignment)
+{
+	++Statistics.Allocations;
+	Statistics.RequestedBytes += bytes;
+
+	auto p(current ? AlignUp(current, alignment) : current);
+
+	if(!p || p > end || size_t(end - p) < bytes)
+	{
+		auto n(next_size);
+
+		while(n < bytes + alignment)
+			n *= 2;
+		current = AllocateChunk(upstream, p_chunks, n, Statistics);
+		end = current + n;
+		if(next_size < MaxChunkSize)
+			next_size *= 2;
+		p = AlignUp(current, alignment);
+	}
+	current = p + bytes;
+	return p;
+}
+
+void
+ArenaResource::do_deallocate(void*, size_t, size_t) noexcept
+{
+	++Statistics.Deallocations;
+}
+
+bool
+ArenaResource::do_is_equal(const memory_resource& other) const noexcept
+{
+	return this == &other;
+}
+
+} // namespace Unilang;
+
@@ -2,7 +2,8 @@
 
 #include "Parser.h"
 #include <cassert> // for assert;
-#include "Lexical.h" // for IsDelimiter, IsGraphicalDelimiter;
+#include "Lexical.h" // for IsDelimiter, IsGraphicalDelimiter, ScanPlainLength,
+//	ScanSpaceLength;
 
 namespace Unilang
 {
@@ -102,6 +103,69 @@ struct SourcedSequenceAppend final
 	}
 };
 
+template<class _tParseResult>
+struct ViewSequenceAdd final
+{
+	ViewByteParserBase& Parser;
+
+	void
+	operator()(_tParseResult& res, const string& arg) const
+	{
+		res.push_back(Parser.MakeLexeme(string_view(arg.data(),
+			arg.length())));
+	}
+};
+
+template<class _tParseResult>
+struct ViewSequenceAppend final
+{
+	ViewByteParserBase& Parser;
+
+	void
+	operator()(_tParseResult& res, char c) const
+	{
+		Parser.AppendLexeme(res.back(), string_view(&c, 1));
+	}
+	void
+	operator()(_tParseResult& res, const string& arg) const
+	{
+		Parser.AppendLexeme(res.back(), string_view(arg.data(),
+			arg.length()));
+	}
+};
+
+template<class _tParseResult>
+struct SourcedViewSequenceAdd final
+{
+	ViewByteParserBase& Parser;
+	const SourceLocation& Location;
+
+	void
+	operator()(_tParseResult& res, const string& arg) const
+	{
+		res.emplace_back(Location, Parser.MakeLexeme(string_view(arg.data(),
+			arg.length())));
+	}
+};
+
+template<class _tParseResult>
+struct SourcedViewSequenceAppend final
+{
+	ViewByteParserBase& Parser;
+
+	void
+	operator()(_tParseResult& res, char c) const
+	{
+		Parser.AppendLexeme(res.back().second, string_view(&c, 1));
+	}
+	void
+	operator()(_tParseResult& res, const string& arg) const
+	{
+		Parser.AppendLexeme(res.back().second, string_view(arg.data(),
+			arg.length()));
+	}
+};
+
 } // unnamed namespace;
 
 
@@ -121,5 +185,151 @@ SourcedByteParser::Update(bool got_delim)
 		GetBufferRef(), update_current);
 }
 
-} // namespace Unilang;
 
+void
+ViewByteParserBase::AppendLexeme(string_view& lexeme, string_view sv)
+{
+	const auto len(sv.length());
+
+	assert(!(position + 1 < len) && "Invalid state found.");
+
+	const auto pos(position + 1 - len);
+
+	// NOTE: The lexeme is kept as a slice of the source as long as the
+	//	appended characters are adjacent and not transformed by unescaping.
+	if(sliced && lexeme.data() + lexeme.length() == source.data() + pos
+		&& source.substr(pos, len) == sv)
+		lexeme = string_view(lexeme.data(), lexeme.length() + len);
+	else
+	{
+		if(sliced)
+		{
+			literals.push_front(string(lexeme.data(), lexeme.length(),
+				literals.get_allocator()));
+			sliced = {};
+		}
+		assert(!literals.empty() && literals.front().data() == lexeme.data()
+			&& "Invalid literal buffer found.");
+
+		auto& str(literals.front());
+
+		str.append(sv.data(), len);
+		lexeme = string_view(str.data(), str.length());
+	}
+}
+
+string_view
+ViewByteParserBase::MakeLexeme(string_view sv)
+{
+	const auto len(sv.length());
+
+	assert(!(position + 1 < len) && "Invalid state found.");
+
+	const auto res(source.substr(position + 1 - len, len));
+
+	if(res == sv)
+	{
+		sliced = true;
+		return res;
+	}
+	literals.push_front(string(sv.data(), len, literals.get_allocator()));
+	sliced = {};
+
+	const auto& str(literals.front());
+
+	return string_view(str.data(), str.length());
+}
+
+
+template<typename _fPlain, typename _fSpace, typename _fChar>
+void
+ViewByteParserBase::ScanBlocks(_fPlain plain, _fSpace space, _fChar handle)
+{
+	while(position < source.length())
+	{
+		// NOTE: Out of literals and escape sequences, runs of plain characters
+		//	and whitespaces are handled in blocks, which is equivalent to the
+		//	handling of each character.
+		if(IsScanningPlain())
+		{
+			const auto rest(source.substr(position));
+
+			if(const auto n = ScanPlainLength(rest))
+			{
+				Skip(n - 1);
+				plain(rest.substr(0, n));
+				Skip(1);
+				continue;
+			}
+			if(const auto n = ScanSpaceLength(rest))
+			{
+				space(rest.substr(0, n));
+				Skip(n);
+				continue;
+			}
+		}
+		handle(source[position]);
+	}
+}
+
+
+void
+ViewByteParser::Update(bool got_delim)
+{
+	UpdateByteRaw(ViewSequenceAdd<ParseResult>{*this},
+		ViewSequenceAppend<ParseResult>{*this}, lexemes, got_delim,
+		GetLexerRef(), GetBufferRef(), update_current);
+}
+
+void
+ViewByteParser::Scan()
+{
+	ScanBlocks([this](string_view run){
+		if(update_current)
+			AppendLexeme(lexemes.back(), run);
+		else
+		{
+			lexemes.push_back(MakeLexeme(run));
+			update_current = true;
+		}
+	}, [this](string_view){
+		update_current = {};
+	}, [this](char c){
+		(*this)(c);
+	});
+}
+
+
+void
+SourcedViewByteParser::Update(bool got_delim)
+{
+	UpdateByteRaw(SourcedViewSequenceAdd<ParseResult>{*this,
+		source_location}, SourcedViewSequenceAppend<ParseResult>{*this},
+		lexemes, got_delim, GetLexerRef(), GetBufferRef(), update_current);
+}
+
+void
+SourcedViewByteParser::Scan()
+{
+	ScanBlocks([this](string_view run){
+		if(update_current)
+			AppendLexeme(lexemes.back().second, run);
+		else
+		{
+			lexemes.emplace_back(source_location, MakeLexeme(run));
+			update_current = true;
+		}
+		source_location.Column += run.length();
+	}, [this](string_view spaces){
+		update_current = {};
+		for(const char c : spaces)
+			if(c != '\n')
+				source_location.Step();
+			else
+				source_location.Newline();
+	}, [this](char c){
+		(*this)(c);
+	});
+}
+
+} // namespace Unilang;
@@ -27,7 +27,7 @@ RecordCompressor::RecordCompressor(const shared_ptr<Environment>& p_root,
 void
 RecordCompressor::AddParents(Environment& e)
 {
-	Traverse(e, e.Parent,
+	Traverse(e, e.parent,
 		[this](const shared_ptr<Environment>& p_dst, const Environment&){
 		return Universe.emplace(*p_dst, CountReferences(p_dst)).second;
 	});
@@ -43,7 +43,7 @@ RecordCompressor::Compress()
 	{
 		auto& e(pr.first.get());
 
-		Traverse(e, e.Parent, [this](const shared_ptr<Environment>& p_dst){
+		Traverse(e, e.parent, [this](const shared_ptr<Environment>& p_dst){
 			auto& count(Universe.at(Unilang::Deref(p_dst)));
 
 			assert(count > 0);
@@ -65,7 +65,7 @@ RecordCompressor::Compress()
 	while(!NewlyReachable.empty())
 	{
 		for(const auto& e : NewlyReachable)
-			Traverse(e, e.get().Parent,
+			Traverse(e, e.get().parent,
 				[&](const shared_ptr<Environment>& p_dst) noexcept{
 				auto& dst(Unilang::Deref(p_dst));
 
@@ -85,7 +85,7 @@ RecordCompressor::Compress()
 	ystdex::retry_on_cond(ystdex::id<>(), [&]() -> bool{
 		bool collected = {};
 
-		Traverse(*p_root, p_root->Parent, [&](const shared_ptr<Environment>&
+		Traverse(*p_root, p_root->parent, [&](const shared_ptr<Environment>&
 			p_dst, Environment& src, EnvironmentParent& parent) -> bool{
 			auto& dst(Unilang::Deref(p_dst));
 
@@ -93,7 +93,8 @@ RecordCompressor::Compress()
 			{
 				if(!ystdex::exists(Universe, ystdex::ref(dst)))
 					return true;
-				Unilang::AssignParent(parent, dst.Parent);
+				src.InvalidateCache();
+				Unilang::AssignParent(parent, dst.parent);
 				collected = true;
 			}
 			return {};
@@ -120,6 +121,38 @@ RecordCompressor::CountStrong(const shared_ptr<Environment>& p) noexcept
 	return size_t(scnt);
 }
 
+bool
+RecordCompressor::IsCompressible(const Environment& root) noexcept
+{
+	auto p_env(&root);
+
+	// NOTE: The limit is only for the pathological long chains.
+	for(size_t n(0); n != 64; ++n)
+	{
+		const auto& poly(p_env->GetParent().GetObject());
+
+		switch(poly.GetKind())
+		{
+		case ParentKind::Empty:
+			return {};
+		case ParentKind::SingleWeak:
+			p_env = static_cast<const SingleWeakParent&>(
+				poly).Get().Lock().get();
+			break;
+		case ParentKind::SingleStrong:
+			p_env = static_cast<const SingleStrongParent&>(poly).Get().get();
+			break;
+		default:
+			return true;
+		}
+		if(!p_env)
+			return {};
+		if(p_env == &root)
+			return true;
+	}
+	return true;
+}
+
 
 TCOAction::TCOAction(Context& ctx, TermNode& term, bool lift)
 	: req_lift_result(lift ? 1 : 0), record_list(ctx.get_allocator()),
@@ -173,6 +206,9 @@ TCOAction::CompressFrameList()
 			else
 				++i;
 		}
+		for(auto& rec : spliced)
+			GetContextRef().RecycleEnvironment(
+				std::get<ActiveEnvironmentPtr>(rec));
 		return removed;
 	});
 }
@@ -16,7 +16,7 @@ string
 TermToString(const TermNode& term, size_t n_skip)
 {
 	if(const auto p = TermToNamePtr(term))
-		return *p;
+		return string(*p);
 
 	const bool non_list(!IsList(term));
 
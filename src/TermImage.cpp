@@ -0,0 +1,469 @@
+﻿// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co.,Ltd.
+
+#include "TermImage.h" // for string, string_view, TermNode, Context,
+//	TermImageCache;
+#include "Evaluation.h" // for QuerySourceTag, TokenValue,
+//	ValueToken, SetSourcedValue;
+#include <climits> // for CHAR_BIT;
+#include <cstring> // for std::memcpy;
+#include <ystdex/cstdio.h> // for ystdex::fexists;
+#include <exception> // for std::exception;
+#include <fstream> // for std::ofstream;
+#include <random> // for std::random_device;
+#include <string> // for std::to_string;
+#include <cstdio> // for std::rename, std::remove;
+#include "TermAccess.h" // for HashSymbolName;
+#include <cstdint> // for std::uint64_t;
+#include <ystdex/string.hpp> // for ystdex::sfmt;
+#include <YSLib/Service/YModules.h>
+#include YFM_YSLib_Service_TextFile // for YSLib::IO::MappedFile,
+//	YSLib::share_move;
+
+namespace Unilang
+{
+
+namespace
+{
+
+enum class ImageTag : unsigned char
+{
+	List,
+	Symbol,
+	SourcedSymbol,
+	String,
+	SourcedString,
+	True,
+	False,
+	Token,
+	Number
+};
+
+// NOTE: The format version is in the end of the magic number. It shall be
+//	increased for any incompatible change of the format or the reader.
+const string_view CacheMagic("\x7FUTC\x03", 5);
+
+
+void
+WriteSize(string& buf, size_t n)
+{
+	while(n >= 0x80)
+	{
+		buf += char((n & 0x7F) | 0x80);
+		n >>= 7;
+	}
+	buf += char(n);
+}
+
+YB_ATTR_nodiscard bool
+ReadSize(string_view& sv, size_t& n) noexcept
+{
+	n = 0;
+	for(size_t shift(0); !sv.empty() && shift < sizeof(size_t) * CHAR_BIT;
+		shift += 7)
+	{
+		const auto c(static_cast<unsigned char>(sv.front()));
+
+		sv.remove_prefix(1);
+		n |= size_t(c & 0x7F) << shift;
+		if(!(c & 0x80))
+			return true;
+	}
+	return {};
+}
+
+void
+WriteBytes(string& buf, string_view sv)
+{
+	WriteSize(buf, sv.size());
+	buf.append(sv.data(), sv.size());
+}
+
+YB_ATTR_nodiscard bool
+ReadBytes(string_view& sv, string_view& res) noexcept
+{
+	size_t n;
+
+	if(ReadSize(sv, n) && n <= sv.size())
+	{
+		res = sv.substr(0, n);
+		sv.remove_prefix(n);
+		return true;
+	}
+	return {};
+}
+
+void
+WriteTag(string& buf, ImageTag tag)
+{
+	buf += char(tag);
+}
+
+void
+WriteLocation(string& buf, const SourceLocation& src_loc)
+{
+	WriteSize(buf, src_loc.Line);
+	WriteSize(buf, src_loc.Column);
+}
+
+YB_ATTR_nodiscard bool
+ReadLocation(string_view& sv, SourceLocation& src_loc) noexcept
+{
+	return ReadSize(sv, src_loc.Line) && ReadSize(sv, src_loc.Column);
+}
+
+template<typename _type>
+YB_ATTR_nodiscard bool
+WriteNumberAs(string& buf, const ValueObject& vo, unsigned char code)
+{
+	if(const auto p = vo.AccessPtr<_type>())
+	{
+		WriteTag(buf, ImageTag::Number);
+		buf += char(code);
+		buf.append(reinterpret_cast<const char*>(p), sizeof(_type));
+		return true;
+	}
+	return {};
+}
+
+template<typename _type>
+YB_ATTR_nodiscard bool
+ReadNumberAs(string_view& sv, ValueObject& vo)
+{
+	if(sv.size() >= sizeof(_type))
+	{
+		_type x;
+
+		std::memcpy(&x, sv.data(), sizeof(_type));
+		sv.remove_prefix(sizeof(_type));
+		vo = x;
+		return true;
+	}
+	return {};
+}
+
+// NOTE: The codes shall be kept consistent in %ReadImageNumber.
+YB_ATTR_nodiscard bool
+WriteImageNumber(string& buf, const ValueObject& vo)
+{
+	return WriteNumberAs<int>(buf, vo, 0)
+		|| WriteNumberAs<unsigned>(buf, vo, 1)
+		|| WriteNumberAs<long long>(buf, vo, 2)
+		|| WriteNumberAs<unsigned long long>(buf, vo, 3)
+		|| WriteNumberAs<double>(buf, vo, 4)
+		|| WriteNumberAs<long>(buf, vo, 5)
+		|| WriteNumberAs<unsigned long>(buf, vo, 6)
+		|| WriteNumberAs<short>(buf, vo, 7)
+		|| WriteNumberAs<unsigned short>(buf, vo, 8)
+		|| WriteNumberAs<signed char>(buf, vo, 9)
+		|| WriteNumberAs<unsigned char>(buf, vo, 10)
+		|| WriteNumberAs<float>(buf, vo, 11)
+		|| WriteNumberAs<long double>(buf, vo, 12);
+}
+
+YB_ATTR_nodiscard bool
+ReadImageNumber(string_view& sv, ValueObject& vo)
+{
+	if(!sv.empty())
+	{
+		const auto code(static_cast<unsigned char>(sv.front()));
+
+		sv.remove_prefix(1);
+		switch(code)
+		{
+		case 0:
+			return ReadNumberAs<int>(sv, vo);
+		case 1:
+			return ReadNumberAs<unsigned>(sv, vo);
+		case 2:
+			return ReadNumberAs<long long>(sv, vo);
+		case 3:
+			return ReadNumberAs<unsigned long long>(sv, vo);
+		case 4:
+			return ReadNumberAs<double>(sv, vo);
+		case 5:
+			return ReadNumberAs<long>(sv, vo);
+		case 6:
+			return ReadNumberAs<unsigned long>(sv, vo);
+		case 7:
+			return ReadNumberAs<short>(sv, vo);
+		case 8:
+			return ReadNumberAs<unsigned short>(sv, vo);
+		case 9:
+			return ReadNumberAs<signed char>(sv, vo);
+		case 10:
+			return ReadNumberAs<unsigned char>(sv, vo);
+		case 11:
+			return ReadNumberAs<float>(sv, vo);
+		case 12:
+			return ReadNumberAs<long double>(sv, vo);
+		}
+	}
+	return {};
+}
+
+void
+WriteUInt64(string& buf, std::uint64_t n)
+{
+	buf.append(reinterpret_cast<const char*>(&n), sizeof(n));
+}
+
+YB_ATTR_nodiscard bool
+ReadUInt64(string_view& sv, std::uint64_t& n) noexcept
+{
+	if(sv.size() >= sizeof(n))
+	{
+		std::memcpy(&n, sv.data(), sizeof(n));
+		sv.remove_prefix(sizeof(n));
+		return true;
+	}
+	return {};
+}
+
+// NOTE: The file is written to a temporary file and then renamed, so
+//	concurrent processes never see a partially written file.
+YB_NONNULL(1) bool
+WriteFileAtomically(const char* path, string_view content)
+{
+	const auto tmp(string(path) + '.' + std::to_string(std::random_device()())
+		.c_str() + ".tmp");
+
+	{
+		std::ofstream ofs(tmp.c_str(), std::ios_base::out
+			| std::ios_base::binary | std::ios_base::trunc);
+
+		if(!(ofs
+			&& ofs.write(content.data(), std::streamsize(content.size()))))
+		{
+			ofs.close();
+			std::remove(tmp.c_str());
+			return {};
+		}
+	}
+	if(std::rename(tmp.c_str(), path) == 0)
+		return true;
+	std::remove(tmp.c_str());
+	return {};
+}
+
+
+// NOTE: The hash is the 64-bit FNV-1a hash. It does not depend on the build
+//	of the interpreter, so the images are reproducible.
+YB_ATTR_nodiscard YB_PURE std::uint64_t
+HashContent(string_view sv) noexcept
+{
+	std::uint64_t h(0xCBF29CE484222325U);
+
+	for(const auto c : sv)
+		h = (h ^ static_cast<unsigned char>(c)) * 0x100000001B3U;
+	return h;
+}
+
+} // unnamed namespace;
+
+
+bool
+WriteTermImage(string& buf, const TermNode& term)
+{
+	if(term.Tags != TermTags::Unqualified)
+		return {};
+	if(IsList(term))
+	{
+		WriteTag(buf, ImageTag::List);
+		WriteSize(buf, term.size());
+		for(const auto& sub : term)
+			if(!WriteTermImage(buf, sub))
+				return {};
+		return true;
+	}
+	if(IsBranch(term))
+		return {};
+
+	const auto& vo(term.Value);
+	const auto o_tag(QuerySourceTag(vo));
+
+	if(const auto p = vo.AccessPtr<TokenValue>())
+	{
+		if(o_tag)
+		{
+			WriteTag(buf, ImageTag::SourcedSymbol);
+			WriteLocation(buf, o_tag->GetLocation());
+		}
+		else
+			WriteTag(buf, ImageTag::Symbol);
+		WriteBytes(buf, *p);
+		return true;
+	}
+	if(const auto p = vo.AccessPtr<string>())
+	{
+		if(o_tag)
+		{
+			WriteTag(buf, ImageTag::SourcedString);
+			WriteLocation(buf, o_tag->GetLocation());
+		}
+		else
+			WriteTag(buf, ImageTag::String);
+		WriteBytes(buf, *p);
+		return true;
+	}
+	if(const auto p = vo.AccessPtr<bool>())
+	{
+		WriteTag(buf, *p ? ImageTag::True : ImageTag::False);
+		return true;
+	}
+	if(const auto p = vo.AccessPtr<ValueToken>())
+	{
+		WriteTag(buf, ImageTag::Token);
+		buf += char(*p);
+		return true;
+	}
+	return WriteImageNumber(buf, vo);
+}
+
+bool
+ReadTermImage(string_view& sv, TermNode& term, Context& ctx)
+{
+	if(sv.empty())
+		return {};
+
+	const auto tag(ImageTag(static_cast<unsigned char>(sv.front())));
+	SourceLocation src_loc;
+	string_view id;
+
+	sv.remove_prefix(1);
+	switch(tag)
+	{
+	case ImageTag::List:
+	{
+		size_t n;
+
+		if(!ReadSize(sv, n))
+			return {};
+		for(; n != 0; --n)
+		{
+			// NOTE: Each subterm takes at least one byte.
+			if(sv.empty())
+				return {};
+
+			auto& sub(*term.emplace());
+
+			if(!ReadTermImage(sv, sub, ctx))
+				return {};
+		}
+		return true;
+	}
+	case ImageTag::Symbol:
+		if(ReadBytes(sv, id))
+		{
+			term.SetValue(ctx.Global.get().Symbols.Intern(id));
+			return true;
+		}
+		break;
+	case ImageTag::SourcedSymbol:
+		if(ReadLocation(sv, src_loc) && ReadBytes(sv, id))
+		{
+			auto& global(ctx.Global.get());
+
+			SetSourcedValue(term, global.Symbols.Intern(id),
+				global.MakeSourceTag(ctx, src_loc));
+			return true;
+		}
+		break;
+	case ImageTag::String:
+		if(ReadBytes(sv, id))
+		{
+			term.SetValue(string(id.data(), id.size(), term.get_allocator()));
+			return true;
+		}
+		break;
+	case ImageTag::SourcedString:
+		if(ReadLocation(sv, src_loc) && ReadBytes(sv, id))
+		{
+			SetSourcedValue(term, id,
+				ctx.Global.get().MakeSourceTag(ctx, src_loc));
+			return true;
+		}
+		break;
+	case ImageTag::True:
+	case ImageTag::False:
+		term.Value = tag == ImageTag::True;
+		return true;
+	case ImageTag::Token:
+		if(!sv.empty())
+		{
+			term.Value = ValueToken(sv.front());
+			sv.remove_prefix(1);
+			return true;
+		}
+		break;
+	case ImageTag::Number:
+		return ReadImageNumber(sv, term.Value);
+	}
+	return {};
+}
+
+
+TermNode
+TermImageCache::Read(Context& ctx, string filename, string_view unit) const
+{
+	const auto& global(ctx.Global.get());
+
+	if(directory.empty())
+	{
+		ctx.CurrentSource = YSLib::share_move(filename);
+		return global.Read(unit, ctx);
+	}
+
+	const auto image_path(directory + '/' + ystdex::sfmt<string>("%016llx.uti",
+		static_cast<unsigned long long>(HashSymbolName(filename))));
+	const auto hash(HashContent(unit));
+
+	if(ystdex::fexists(image_path.c_str()))
+		try
+		{
+			const YSLib::IO::MappedFile mapped(image_path.c_str());
+			string_view sv(reinterpret_cast<const char*>(mapped.GetPtr()),
+				mapped.GetSize());
+			string_view name;
+			std::uint64_t size, h;
+
+			if(sv.substr(0, CacheMagic.size()) == CacheMagic)
+			{
+				sv.remove_prefix(CacheMagic.size());
+				if(ReadBytes(sv, name) && name == filename
+					&& ReadUInt64(sv, size) && size == unit.size()
+					&& ReadUInt64(sv, h) && h == hash && !sv.empty()
+					&& (sv.front() != char()) == global.UseSourceLocation)
+				{
+					TermNode term(global.Allocator);
+
+					sv.remove_prefix(1);
+					ctx.CurrentSource = YSLib::share_move(filename);
+					if(ReadTermImage(sv, term, ctx) && sv.empty())
+						return term;
+					// NOTE: The image is corrupted. The source name is
+					//	restored for the reader.
+					filename = *ctx.CurrentSource;
+				}
+			}
+		}
+		catch(std::exception&)
+		{}
+
+	string buf(global.Allocator);
+
+	buf.append(CacheMagic.data(), CacheMagic.size());
+	WriteBytes(buf, filename);
+	WriteUInt64(buf, unit.size());
+	WriteUInt64(buf, hash);
+	buf += char(global.UseSourceLocation);
+	ctx.CurrentSource = YSLib::share_move(filename);
+
+	auto term(global.Read(unit, ctx));
+
+	if(WriteTermImage(buf, term))
+		WriteFileAtomically(image_path.c_str(), buf);
+	return term;
+}
+
+} // namespace Unilang;
+